@@ -1,99 +1,244 @@
 #include "axo.h"
+#include "include/core/hit_index.h"
+#include "include/core/intern.h"
+#include <math.h>
+#include <stdio.h>
 
 Font_ttf* global_font = NULL;
 
 void axInit(void) {
     // Set default theme (e.g., dark mode)
     set_theme(&THEME_DARK);
+
+    // Warm the font registry with the icon font at the size container
+    // close buttons use, so the first frame doesn't open/parse the file
+    float dpi = get_display_dpi(0);
+    preload_font_ttf(ICON_FONT_FILE, (int)roundf(current_theme->default_font_size * 0.9f * dpi), 0);
 }
 
 int is_any_text_widget_active(void) {
-    // Check entries
-    for (int i = 0; i < entrys_count; i++) {
-        if (entry_widgets[i] && entry_widgets[i]->is_active) {
-            return 1;
+    int n;
+    const axWidgetEntry *widgets = axGetWidgets(&n);
+    for (int i = 0; i < n; i++) {
+        const axWidgetEntry *e = &widgets[i];
+        if (!e->widget) continue;
+        if (e->cls == &entry_class && ((axEntry *)e->widget)->is_active) return 1;
+        if (e->cls == &textbox_class && ((axTextBox *)e->widget)->is_active) return 1;
+        // An open dropdown takes type-ahead
+        if (e->cls == &dropdown_class && ((axDropDown *)e->widget)->is_expanded) return 1;
+    }
+    return 0;
+}
+
+/* ---------- event routing ---------- */
+// Adds every interactive widget in paint order, so the last one drawn is
+// the first one hit. Classes without bounds (texts, progress bars, images)
+// ignore events and stay out of the index.
+static void build_hit_index(void) {
+    int n;
+    const axWidgetEntry *widgets = axGetWidgets(&n);
+    hit_index_begin();
+    for (int i = 0; i < n; i++) {
+        const axWidgetClass *cls = widgets[i].cls;
+        Rect r;
+        if (!widgets[i].widget || !cls->bounds || !cls->bounds(widgets[i].widget, &r)) continue;
+        hit_index_add(r, widgets[i].widget, cls->update, cls->update_phase, cls->hit_flags);
+    }
+    hit_index_end();
+}
+
+// Routes one event through theme hotkeys and the widgets it concerns.
+// Returns 0 when the app should quit.
+static int dispatch_event(axEvent *event) {
+    if (event->type == EVENT_QUIT) return 0;
+
+    // Window contents are no longer what we last presented
+    if (event->type == EVENT_WINDOWRESIZED || event->type == EVENT_WINDOWEXPOSED) {
+        axInvalidateAll();
+        hit_index_invalidate();
+    }
+
+    // === THEME SWITCHING (F1–F10) ===
+    if (event->type == EVENT_KEYDOWN) {
+        const Theme *before = current_theme;
+        switch (event->key.key) {
+            case KEY_F1:  set_theme(&THEME_LIGHT); break;
+            case KEY_F2:  set_theme(&THEME_DARK); break;
+            case KEY_F3:  set_theme(&THEME_HACKER); break;
+            case KEY_F4:  set_theme(&THEME_IMGUI_DARK); break;
+            case KEY_F5:  set_theme(&THEME_NUKLEAR); break;
+            case KEY_F6:  set_theme(&THEME_MATERIAL_DARK); break;
+            case KEY_F7:  set_theme(&THEME_DRACULA); break;
+            case KEY_F8:  set_theme(&THEME_NORD); break;
+            case KEY_F9:  set_theme(&THEME_SOLARIZED_DARK); break;
+            case KEY_F10: set_theme(&THEME_WIN95); break;
         }
+        if (current_theme != before) axInvalidateAll();
+    }
+
+    // === UPDATE THE WIDGETS UNDER THE POINTER / WITH FOCUS ===
+    if (!hit_index_valid()) build_hit_index();
+    hit_index_dispatch(event);
+    return 1;
+}
+
+// Text input follows whether an entry or textbox has focus; checked once
+// per batch of events rather than after every one
+static void sync_text_input(void) {
+    if (is_any_text_widget_active()) {
+        SDL_StartTextInput();
+    } else {
+        SDL_StopTextInput();
+    }
+}
+
+/* ---------- profiler overlay ---------- */
+#define OVERLAY_LINES 8
+
+static Rect overlay_rect(const axParent *parent) {
+    float dpi = parent->base.dpi_scale;
+    int line_h = global_font ? ttf_line_skip(global_font) : (int)roundf(16 * dpi);
+    return (Rect){ (int)roundf(8 * dpi), (int)roundf(8 * dpi),
+                   (int)roundf(300 * dpi), line_h * OVERLAY_LINES + (int)roundf(8 * dpi) };
+}
+
+static void render_profiler_overlay(axParent *parent) {
+    if (!axProfilerOverlayVisible() || !global_font) return;
+
+    Base *base = &parent->base;
+    Rect r = overlay_rect(parent);
+    int line_h = ttf_line_skip(global_font);
+    int pad = (int)roundf(4 * base->dpi_scale);
+
+    clip_begin(base, NULL);
+    draw_rect(base, r.x, r.y, r.w, r.h, (Color){0, 0, 0, 190});
+
+    char line[96];
+    axProfileStats st;
+    int y = r.y + pad;
+    const axProfilePhase phases[] = { AX_PHASE_FRAME, AX_PHASE_POLL, AX_PHASE_PRESENT };
+    for (int i = 0; i < 3; i++, y += line_h) {
+        axProfilerGetPhase(phases[i], &st);
+        snprintf(line, sizeof line, "%-8s %6.2f  p50 %6.2f  p99 %6.2f ms",
+                 axProfilerPhaseName(phases[i]), st.last, st.p50, st.p99);
+        draw_text_from_font(base, global_font, line, r.x + pad, y, COLOR_WHITE, ALIGN_LEFT);
     }
-    // Check textboxes
-    for (int i = 0; i < textboxs_count; i++) {
-        if (textbox_widgets[i] && textbox_widgets[i]->is_active) {
-            return 1;
+    for (int c = 0; c < AX_COUNTER_COUNT; c++, y += line_h) {
+        axProfilerGetCounter((axProfileCounter)c, &st);
+        snprintf(line, sizeof line, "%-15s %5.0f  p50 %5.0f  p99 %5.0f",
+                 axProfilerCounterName((axProfileCounter)c), st.last, st.p50, st.p99);
+        draw_text_from_font(base, global_font, line, r.x + pad, y, COLOR_WHITE, ALIGN_LEFT);
+    }
+    clip_end(base);
+}
+
+static void render_all_widgets(void) {
+    axRenderAllWidgets();
+}
+
+// Visibility pass: widgets off the window or outside their container are
+// skipped by every render_all_widgets call this frame
+static void cull_widgets(axParent *parent) {
+    Rect view = { 0, 0, 0, 0 };
+    get_render_size(&parent->base, &view.w, &view.h);
+    registry_cull(&view);
+}
+
+// Repaints only the damaged rectangles into the persistent backbuffer
+static void render_damage(axParent *parent) {
+    Base *base = &parent->base;
+    int full_w, full_h;
+    get_render_size(base, &full_w, &full_h);
+
+    int target = backbuffer_begin(base);
+    if (target == 2) axInvalidateAll();   // fresh texture, nothing to keep
+
+    // The overlay refreshes whenever something else repaints, so an idle
+    // window stays idle
+    if (axProfilerOverlayVisible()) axInvalidateRect(overlay_rect(parent));
+
+    Rect damage[REDRAW_MAX_RECTS];
+    int n = redraw_take_damage(damage, full_w, full_h);
+    cull_widgets(parent);
+
+    if (!target) {
+        // No render targets: fall back to a full frame, still only when dirty
+        clear_screen(base, parent->color);
+        render_all_widgets();
+        render_profiler_overlay(parent);
+        PROFILED(AX_PHASE_PRESENT, present_screen(base));
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        set_damage_clip(base, &damage[i]);
+        // SDL_RenderClear ignores the clip rect, so clear with a fill
+        draw_rect(base, damage[i].x, damage[i].y, damage[i].w, damage[i].h, parent->color);
+        render_all_widgets();
+        render_profiler_overlay(parent);
+    }
+    set_damage_clip(base, NULL);
+    PROFILED(AX_PHASE_PRESENT, backbuffer_present(base));
+}
+
+int axRunFrame(axParent *parent) {
+    axEvent event;
+    profiler_frame_begin();
+    hit_index_invalidate();   // widgets may have been moved or added since last frame
+    // One pump per frame: events arriving while this batch is dispatched
+    // wait for the next frame, and bursts of motion arrive merged
+    PROFILED(AX_PHASE_POLL, pump_events());
+    while (next_event(&event)) {
+        if (!dispatch_event(&event)) {
+            profiler_frame_end(0);
+            return 0;
         }
     }
-    return 0;
+    sync_text_input();
+
+    // Async images decoded since the last frame become textures, within
+    // a per-frame budget
+    int loaded;
+    PROFILED(AX_PHASE_IMAGE_UPLOAD, loaded = image_backend_upload(IMAGE_UPLOAD_BUDGET_MS));
+    if (loaded > 0) image_sync_loads();
+
+    if (axGetRedrawMode() == AX_REDRAW_ON_DEMAND) {
+        int rendered = axIsDirty();
+        if (rendered) render_damage(parent);
+        profiler_frame_end(rendered);
+        return 1;
+    }
+
+    // === RENDER ===
+    clear_screen(&parent->base, parent->color);
+    cull_widgets(parent);
+    render_all_widgets();
+    render_profiler_overlay(parent);
+    PROFILED(AX_PHASE_PRESENT, present_screen(&parent->base));
+    profiler_frame_end(1);
+    return 1;
 }
 
 void axRun(axParent *parent) {
     axEvent event;
     int running = 1;
+    axInvalidateAll();
     while (running) {
-        while (poll_event(&event)) {
-            if (event.type == EVENT_QUIT) {
-                running = 0;
-            } else {
-                // === THEME SWITCHING (F1–F10) ===
-                if (event.type == EVENT_KEYDOWN) {
-                    switch (event.key.key) {
-                        case KEY_F1:  set_theme(&THEME_LIGHT); break;
-                        case KEY_F2:  set_theme(&THEME_DARK); break;
-                        case KEY_F3:  set_theme(&THEME_HACKER); break;
-                        case KEY_F4:  set_theme(&THEME_IMGUI_DARK); break;
-                        case KEY_F5:  set_theme(&THEME_NUKLEAR); break;
-                        case KEY_F6:  set_theme(&THEME_MATERIAL_DARK); break;
-                        case KEY_F7:  set_theme(&THEME_DRACULA); break;
-                        case KEY_F8:  set_theme(&THEME_NORD); break;
-                        case KEY_F9:  set_theme(&THEME_SOLARIZED_DARK); break;
-                        case KEY_F10: set_theme(&THEME_WIN95); break;
-                    }
-                }
-
-                // === UPDATE ALL WIDGETS ===
-                axUpdateAllRegisteredContainers(&event);
-                axUpdateAllRegisteredRadioButtons(&event);
-                axUpdateAllRegisteredEntries(&event);
-            	axUpdateAllRegisteredTextBoxes(&event);
-                axUpdateAllRegisteredSliders(&event);
-                axUpdateAllRegisteredButtons(&event);
-                axUpdateAllRegisteredTexts(&event);     // ← Added
-                axUpdateAllRegisteredDropDown(&event);
-                axUpdateAllRegisteredProgressBars(&event);
-                axUpdateAllRegisteredImages(&event);
-
-                // Text input management
-                if (is_any_text_widget_active()) {
-                    SDL_StartTextInput();
-                } else {
-                    SDL_StopTextInput();
-                }
-            }
+        // On demand: sleep in the event queue until something happens
+        if (axGetRedrawMode() == AX_REDRAW_ON_DEMAND && !axIsDirty() &&
+            wait_event(&event, REDRAW_IDLE_TIMEOUT_MS)) {
+            running = dispatch_event(&event);
+            sync_text_input();
         }
-
-        // === RENDER ===
-        clear_screen(&parent->base, parent->color);
-        axRenderAllRegisteredContainers();
-        axRenderAllRegisteredDropDown();
-        axRenderAllRegisteredRadioButtons();
-        axRenderAllRegisteredEntries();
-        axRenderAllRegisteredTextBoxes();
-        axRenderAllRegisteredSliders();
-        axRenderAllRegisteredButtons();
-        axRenderAllRegisteredTexts();
-        axRenderAllRegisteredProgressBars();
-        axRenderAllRegisteredImages();
-        present_screen(&parent->base);
+        if (running) running = axRunFrame(parent);
     }
 
     // === CLEANUP ===
-    axFreeAllRegisteredImages();
-    axFreeAllRegisteredButtons();
-    axFreeAllRegisteredDropDown();
-    axFreeAllRegisteredRadioButtons();
-    axFreeAllRegisteredTexts();
-    axFreeAllRegisteredContainers();
-    axFreeAllRegisteredEntries();
-    axFreeAllRegisteredProgressBars();
-    axFreeAllRegisteredSliders();
-    axFreeAllRegisteredTextBoxes();  // ← Match name above
+    axFreeAllWidgets(NULL);
+    intern_reset();   // labels and placeholders, in one go
+    radio_groups_reset();
+    image_async_shutdown();   // drops the jobs' references, so the clear takes those too
+    image_cache_clear();   // textures no widget holds any more
 
     free_parent(parent);
 }
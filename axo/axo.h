@@ -4,6 +4,9 @@
 
 #include"include/core/parent.h"
 #include"include/core/theme.h"
+#include"include/core/redraw.h"
+#include"include/core/profiler.h"
+#include"include/core/registry.h"
 #include"include/widgets/container.h"
 #include"include/widgets/entry.h"
 #include"include/widgets/drop.h"
@@ -26,5 +29,9 @@ int is_any_text_widget_active(void);
 
 void axRun(axParent *parent);
 
+// Handles pending events and renders one frame without blocking.
+// Returns 0 once a quit event was seen. Handy for headless runs.
+int axRunFrame(axParent *parent);
+
 
 #endif // AXO_H
@@ -0,0 +1,38 @@
+/**
+ * @file headless.h
+ * @brief Windowless backend that renders into an in-memory RGBA framebuffer
+ *
+ * The framebuffer is an SDL surface driven by SDL's software renderer, so
+ * every draw_* path, the draw list and the text atlas work unchanged with
+ * no window, display or GPU. Input comes from input_push_event.
+ */
+
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <SDL2/SDL.h>
+#include "../sdl2/sdl2.h"
+
+/**
+ * @brief Creates a w x h RGBA framebuffer and a software renderer for it.
+ *        Enables the virtual mouse so scripted events drive hover/drag.
+ * @return 1 on success, 0 on failure (base is left zeroed)
+ */
+int  headless_create(Base *base, int w, int h);
+
+/**
+ * @brief Tears down what headless_create set up, plus the shared font and
+ *        SDL state destroy_window would release.
+ */
+void headless_destroy(Base *base);
+
+/**
+ * @brief Returns the framebuffer pixels (RGBA, 8 bits per channel) after
+ *        flushing pending drawing. NULL if base is not headless.
+ */
+const Uint8* headless_pixels(Base *base, int *w, int *h, int *pitch);
+
+// Writes the framebuffer as a PNG; 0 on failure
+int  headless_save_png(Base *base, const char *path);
+
+#endif // HEADLESS_H
@@ -20,11 +20,35 @@ void destroy_window(Base *base);
 
 typedef struct { int x, y, w, h; } Rect;
 
-// Save current clip and set a new one
+/* ----- clipping -------------------------------------------------------- */
+#define CLIP_STACK_DEPTH 16   // nesting beyond this still clips, but is not remembered
+
+// Pushes a clip: `rect` intersected with the active one (NULL = keep the
+// active clip). Every clip_begin needs a matching clip_end.
 void clip_begin(Base *base, const Rect *rect);
 
-// Restore previous clip (call after drawing)
+// Pops the clip pushed by the matching clip_begin
 void clip_end(Base *base);
+
+// 0 if `rect` lies entirely outside the active clip, so drawing it would
+// touch no pixels and can be skipped
+int clip_visible(Base *base, const Rect *rect);
 int rect_intersect(const Rect *a, const Rect *b, Rect *result);
 
+/* ----- on-demand redraw ----------------------------------------------- */
+// Output size of the renderer in physical pixels
+void get_render_size(Base *base, int *w, int *h);
+
+// Restricts every clip_begin that follows to `rect` (NULL = whole target),
+// so a redraw pass only touches the damaged area
+void set_damage_clip(Base *base, const Rect *rect);
+
+// Redirects drawing into an offscreen texture that keeps its contents
+// between frames. Returns 0 if render targets are not supported, 2 if the
+// texture was (re)created and its contents are undefined, 1 otherwise.
+int  backbuffer_begin(Base *base);
+
+// Copies the backbuffer to the window and presents it
+void backbuffer_present(Base *base);
+
 #endif /* SDL2_BACKEND_H */
@@ -0,0 +1,53 @@
+/**
+ * @file sdl2_batch.h
+ * @brief Draw list that collects primitives and submits them with as few
+ *        SDL_RenderGeometry calls as possible
+ *
+ * Every draw_* function records into the list instead of talking to the
+ * renderer. Primitives that share a texture and clip rect are merged into
+ * one command; a primitive may also join an earlier command with the same
+ * state as long as nothing recorded in between overlaps it, so painter's
+ * order is preserved. The list is flushed on present, clear, render-target
+ * changes and before any texture it may reference is destroyed.
+ */
+
+#ifndef SDL2_BATCH_H
+#define SDL2_BATCH_H
+
+#include <SDL2/SDL.h>
+
+#define BATCH_LOOKBACK   8        // commands searched for a merge target
+#define BATCH_MAX_VERTS  65536    // flush early beyond this many vertices
+
+typedef struct {
+    unsigned long ops;            // primitives recorded
+    unsigned long draw_calls;     // SDL_RenderGeometry calls issued
+    unsigned long flushes;        // non-empty flushes
+} BatchStats;
+
+/* Records an indexed triangle list. tex may be NULL for solid colour. */
+void batch_geometry(SDL_Renderer* ren, SDL_Texture* tex,
+                    const SDL_Vertex* verts, int vert_count,
+                    const int* indices, int index_count);
+
+void batch_rect(SDL_Renderer* ren, float x, float y, float w, float h, SDL_Color color);
+void batch_rects(SDL_Renderer* ren, const SDL_Rect* rects, int count, SDL_Color color);
+void batch_triangle(SDL_Renderer* ren, float x1, float y1, float x2, float y2,
+                    float x3, float y3, SDL_Color color);
+
+/* Textured quad; src NULL = whole texture. tint multiplies the texels
+ * (white = unchanged). */
+void batch_texture(SDL_Renderer* ren, SDL_Texture* tex, const SDL_Rect* src,
+                   const SDL_Rect* dst, SDL_Color tint);
+
+/* Clip rect for everything recorded from now on (NULL = none). The caller
+ * keeps the renderer's own clip in sync for immediate-mode drawing. */
+void batch_set_clip(const SDL_Rect* clip);
+
+/* Submits everything recorded so far. Cheap when the list is empty. */
+void batch_flush(void);
+
+void batch_get_stats(BatchStats* out);
+void batch_reset_stats(void);
+
+#endif // SDL2_BATCH_H
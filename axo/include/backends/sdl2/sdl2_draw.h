@@ -49,6 +49,23 @@ void draw_rect(Base* base, int x, int y, int w, int h, Color color);
  */
 void draw_circle(Base* base, int x, int y, int radius, Color color);
 
+/**
+ * @brief Draws a filled circle with anti-aliased edges
+ *        (same centre and radius convention as draw_circle)
+ * @param base Pointer to the Base struct containing the renderer
+ * @param x X-coordinate of the circle's center
+ * @param y Y-coordinate of the circle's center
+ * @param radius Radius of the circle
+ * @param color The fill color of the circle (alpha is respected)
+ */
+void draw_circle_aa(Base* base, int x, int y, int radius, Color color);
+
+/**
+ * @brief Drops the cached circle sprites created on `ren`.
+ *        Must be called before the renderer is destroyed.
+ */
+void draw_release_renderer(SDL_Renderer* ren);
+
 /**
  * @brief Draws a filled triangle with the specified vertices
  * @param base Pointer to the Base struct containing the renderer
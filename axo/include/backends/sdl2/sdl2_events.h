@@ -18,7 +18,8 @@ typedef enum {
     EVENT_MOUSEWHEEL,
     EVENT_WINDOWRESIZED,
     EVENT_WINDOWCLOSE,
-    EVENT_QUIT
+    EVENT_QUIT,
+    EVENT_WINDOWEXPOSED     // window contents were lost and must be repainted
 } EventType;
 
 /* --------------------------------------------------------------------- */
@@ -89,6 +90,20 @@ typedef struct {
 Key translate_sdl_key(SDL_Scancode sc);
 int translate_sdl_event(const SDL_Event *s, axEvent *out);
 int poll_event(axEvent *out);
+// Blocks up to timeout_ms for the next event; 0 on timeout or an event
+// that has no axEvent translation
+int wait_event(axEvent *out, int timeout_ms);
+
+/* ----- Batched pumping ------------------------------------------------ */
+/* Drains the injected and OS queues into one batch of at most
+ * EVENT_BATCH_SIZE events, merging runs of mouse motion into a single
+ * event (latest position and buttons, summed dx/dy). Whatever does not
+ * fit stays queued for the next pump. Returns the events now batched. */
+#define EVENT_BATCH_SIZE 256
+int pump_events(void);
+/* Next event of the batch; 0 once it is empty. Never touches the OS queue. */
+int next_event(axEvent *out);
+
 void enable_text_input(void);
 void disable_text_input(void);
 
@@ -97,9 +112,18 @@ void disable_text_input(void);
 /* --------------------------------------------------------------------- */
 
 /* ----- Mouse ---------------------------------------------------------- */
+/* Position from the last pointer event poll_event / wait_event /
+ * next_event returned; SDL is only asked before the first one. */
 void input_get_mouse(int *x, int *y);
 bool input_mouse_down(MouseButton btn);
 
+/* ----- Scripted input -------------------------------------------------- */
+/* Queues an event ahead of the OS queue; 0 if the queue is full. */
+int  input_push_event(const axEvent *ev);
+/* When enabled, input_get_mouse / input_mouse_down report the position
+ * and buttons of the injected events instead of the real pointer. */
+void input_set_virtual_mouse(bool enabled);
+
 /* ----- Keyboard modifiers --------------------------------------------- */
 Uint16 input_get_mod_state(void);
 
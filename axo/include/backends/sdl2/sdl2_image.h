@@ -2,16 +2,86 @@
 #define SDL2_IMAGE_H
 
 #include <SDL2/SDL.h>
+#include <stddef.h>
 
-/* Opaque handle that the backend uses */
-typedef struct {
-    SDL_Texture *texture;   /* owned by the backend */
+#define IMAGE_WORKERS_MAX       4   /* decoder threads, at most        */
+#define IMAGE_UPLOAD_BUDGET_MS  4   /* texture uploads per frame, ms   */
+
+typedef enum {
+    IMAGE_READY,
+    IMAGE_LOADING,   /* decoding on a worker, no texture yet */
+    IMAGE_FAILED
+} ImageState;
+
+/* Shared, refcounted texture. Loading the same file (or the same bytes)
+ * again returns the same handle; the fields past `texture` belong to the
+ * cache. */
+typedef struct ImageHandle {
+    SDL_Texture *texture;   /* owned by the cache; NULL once its renderer is gone */
+    int          w, h;      /* texture size in pixels */
+    ImageState   state;
+
+    SDL_Renderer       *ren;
+    char               *path;       /* canonical path, NULL for memory images */
+    Uint64              hash;       /* of the canonical path or the bytes */
+    size_t              size;       /* byte count of a memory image */
+    size_t              bytes;      /* texture bytes held */
+    int                 refs;
+    struct ImageHandle *bucket_next;
+    struct ImageAlias  *aliases;    /* raw spellings of the path that hit this handle */
+    struct ImageHandle *lru_prev;   /* unreferenced handles only, towards most recent */
+    struct ImageHandle *lru_next;
 } ImageHandle;
 
-/* Backend entry points */
+/* Backend entry points. Every load takes a reference that
+ * image_backend_free gives back. */
 ImageHandle *image_backend_load(SDL_Renderer *ren, const char *path);
+/* Embedded assets: keyed by a hash of the bytes, which need not outlive the call */
+ImageHandle *image_backend_load_mem(SDL_Renderer *ren, const void *data, size_t size);
+ImageHandle *image_backend_retain(ImageHandle *h);
 void image_backend_draw(SDL_Renderer *ren, ImageHandle *h,
                                 int sx, int sy, int sw, int sh);
 void image_backend_free(ImageHandle *h);
 
+/* ------------------------------------------------------------------ */
+/*  Async loading                                                      */
+/* ------------------------------------------------------------------ */
+/* Same keys and references as the blocking loads, but the handle comes
+ * back IMAGE_LOADING with no texture while a worker thread decodes the
+ * file into a surface. Falls back to a blocking load if no thread
+ * could be started. */
+ImageHandle *image_backend_load_async(SDL_Renderer *ren, const char *path);
+/* The bytes are copied, so they need not outlive the call */
+ImageHandle *image_backend_load_mem_async(SDL_Renderer *ren, const void *data, size_t size);
+/* Main thread, once per frame: turns decoded surfaces into textures for
+ * up to budget_ms (at least one). Returns how many loads finished. */
+int  image_backend_upload(Uint32 budget_ms);
+/* Stops the workers and drops the loads still in flight; destroy_window
+ * calls it, so any teardown path joins the threads */
+void image_async_shutdown(void);
+
+/* ------------------------------------------------------------------ */
+/*  Cache                                                              */
+/* ------------------------------------------------------------------ */
+/* Unreferenced textures stay cached for the next load until the bytes
+ * held exceed the budget; then the least recently released go first.
+ * Referenced textures and the most recently released one are never
+ * evicted. */
+typedef struct {
+    Uint64 hits;
+    Uint64 misses;
+    Uint64 evictions;
+    size_t bytes;          /* texture bytes currently held */
+    size_t budget;         /* eviction threshold           */
+    int    entries;
+    int    referenced;     /* entries some widget still holds */
+} ImageCacheStats;
+
+void image_cache_stats(ImageCacheStats *out);
+void image_cache_set_budget(size_t bytes);   /* default 32 MiB */
+void image_cache_clear(void);                /* drops every unreferenced texture */
+/* Textures die with their renderer: drops the unreferenced ones and
+ * empties the rest, which then draw nothing. */
+void image_release_renderer(SDL_Renderer *ren);
+
 #endif /* SDL2_IMAGE_H */
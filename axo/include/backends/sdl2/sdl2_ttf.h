@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "sdl2.h"
+#include "sdl2_batch.h"
 #include "../../core/color.h"
 /**
  * @brief Text alignment options for draw_text_from_font_
@@ -25,6 +26,31 @@ typedef struct Font_ttf Font_ttf;
 Font_ttf* load_font_ttf(const char* path, int ptsize);
 void      free_font_ttf(Font_ttf* f);
 
+/* Drops the glyph-atlas pages every font holds on `ren`.
+ * Must be called before the renderer is destroyed. */
+void      ttf_release_renderer(SDL_Renderer* ren);
+
+/* ------------------------------------------------------------------ */
+/*  Font registry – shared, refcounted handles                        */
+/* ------------------------------------------------------------------ */
+#define ICON_FONT_FILE "../axo/asset/icons/MaterialSymbolsOutlined-Regular.ttf"
+
+/* Returns the shared font for (source, ptsize, dpi), opening it on first
+ * use. dpi 0 keeps SDL_ttf's default (72). Failed opens are remembered,
+ * so a missing file is reported once instead of on every draw.
+ * Pair every successful acquire with release_font_ttf – never
+ * free_font_ttf a registry font. */
+Font_ttf* acquire_font_ttf(const char* path, int ptsize, unsigned dpi);
+/* Memory-backed source (e.g. the embedded fira_code_ttf blob); the
+ * buffer must outlive the registry. Keyed by address and size. */
+Font_ttf* acquire_font_mem(const void* mem, int size, int ptsize, unsigned dpi);
+void      release_font_ttf(Font_ttf* f);
+
+/* Opens a font ahead of time and keeps it cached with no references. */
+void      preload_font_ttf(const char* path, int ptsize, unsigned dpi);
+/* Closes every registered font (called from destroy_window). */
+void      font_registry_clear(void);
+
 /* ------------------------------------------------------------------ */
 /*  Render modes                                                      */
 /* ------------------------------------------------------------------ */
@@ -55,13 +81,57 @@ TTF_TextResult render_text_ttf(
 /* Helper to free the texture */
 static inline void free_ttf_result(TTF_TextResult* r)
 {
-    if (r && r->texture) SDL_DestroyTexture(r->texture);
+    if (r && r->texture) {
+        batch_flush();   /* queued quads may still reference it */
+        SDL_DestroyTexture(r->texture);
+    }
 }
 
+/* ------------------------------------------------------------------ */
+/*  Rendered-string cache                                             */
+/* ------------------------------------------------------------------ */
+/* Same as render_text_ttf, but the texture is kept in a bounded LRU
+ * cache keyed by (renderer, font, text, colours, mode).
+ * The result is owned by the cache – never pass it to free_ttf_result.
+ * It stays valid until the next cached render call. */
+TTF_TextResult render_text_ttf_cached(
+        SDL_Renderer*    ren,
+        Font_ttf*        font,
+        const char*      utf8_text,
+        TTF_RenderMode   mode,
+        SDL_Color        fg,
+        SDL_Color        bg);
+
+typedef struct {
+    Uint64 hits;
+    Uint64 misses;
+    Uint64 evictions;
+    size_t bytes;          /* texture bytes currently held */
+    size_t budget;         /* eviction threshold           */
+    int    entries;
+} TTF_TextCacheStats;
+
+void ttf_text_cache_stats(TTF_TextCacheStats* out);
+void ttf_text_cache_set_budget(size_t bytes);   /* default 8 MiB */
+void ttf_text_cache_clear(void);
+
 /* ------------------------------------------------------------------ */
 /*  Measurement helpers                                               */
 /* ------------------------------------------------------------------ */
+/* Widths come from a per-font cache of glyph advances and kerning,
+ * not from TTF_SizeUTF8, so they are cheap enough for per-key loops. */
 int ttf_text_width (Font_ttf* f, const char* text);
+int ttf_text_width_n(Font_ttf* f, const char* text, int len);
+/* Caret x of every byte offset of `text` in one pass: out_offsets[i] is
+ * the pen position before byte i, out_offsets[len] the full width (bytes
+ * inside a UTF-8 sequence get the position after it). `out_offsets` must
+ * hold strlen(text) + 1 (resp. len + 1) ints. Returns the full width. */
+int ttf_measure_prefix_widths  (Font_ttf* f, const char* text, int* out_offsets);
+int ttf_measure_prefix_widths_n(Font_ttf* f, const char* text, int len, int* out_offsets);
+/* Byte offset of the caret nearest pen position x, given the offsets of
+ * text[0, len) from above. Always a character start, never inside a
+ * UTF-8 sequence. */
+int ttf_caret_at_x(const char* text, const int* offsets, int len, int x);
 int ttf_text_height(Font_ttf* f, const char* text);
 int ttf_line_skip  (Font_ttf* f);
 
@@ -90,6 +160,18 @@ int ttf_size_utf8     (Font_ttf* f, const char* text,
  * @param align Text alignment (ALIGN_LEFT, ALIGN_CENTER, ALIGN_RIGHT)
  */
 void draw_text_from_font(Base* base, void* font, const char* text, int x, int y, Color color, TextAlign align);
+/**
+ * @brief Same as draw_text_from_font, but draws only the first `len` bytes
+ *        of `text`, which need not be NUL-terminated. Lets callers draw a
+ *        slice of a larger buffer without copying it.
+ */
+void draw_text_from_font_n(Base* base, void* font, const char* text, int len, int x, int y, Color color, TextAlign align);
+/**
+ * @brief Same as draw_text_from_font, but blits a cached texture of the whole
+ *        string (one copy per frame). Meant for static labels; text that
+ *        changes every frame should use draw_text_from_font instead.
+ */
+void draw_text_cached(Base* base, void* font, const char* text, int x, int y, Color color, TextAlign align);
 /**
  * @brief Draws text at the specified position with the given font size and color
  * @param base Pointer to the Base struct containing the renderer
@@ -6,6 +6,8 @@
 #include"../backends/sdl2/sdl2.h"
 #include"../backends/sdl2/sdl2_events.h"
 #include"../backends/sdl2/sdl2_image.h"
+//------------------HEADLESS (software raster, no window)------------------
+#include"../backends/headless/headless.h"
 
 #include "debug.h"
 
@@ -5,6 +5,7 @@
 #ifndef COLOR_H
 #define COLOR_H
 
+#include <stdbool.h>
 #include <SDL2/SDL_stdinc.h> // this defines Uint8
 /**
  * @struct Color
@@ -17,6 +18,23 @@ typedef struct {
     Uint8 a;  // Alpha component (0-255)
 } Color;
 
+/**
+ * @struct ColorOverride
+ * @brief An optional per-widget color, stored inline in the widget
+ *        (set == false means "use the theme")
+ */
+typedef struct {
+    Color color;
+    bool  set;
+} ColorOverride;
+
+#define COLOR_OVERRIDE(c) ((ColorOverride){ (c), true })
+
+// The override if set, the theme color otherwise
+static inline Color color_or(ColorOverride o, Color fallback) {
+    return o.set ? o.color : fallback;
+}
+
 // Color manipulation helpers
 /**
  * @brief Darkens a color by a factor (0.0 = no change, 1.0 = black)
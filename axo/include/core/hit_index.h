@@ -0,0 +1,60 @@
+/**
+ * @file hit_index.h
+ * @brief Per-frame spatial index over widget bounds, used to route events
+ *
+ * Every interactive widget adds its physical rectangle (already clipped to
+ * its container) once per frame, in paint order. The rectangles go into a
+ * uniform grid, so finding the widget under the pointer looks at one cell
+ * instead of every widget. Dispatch then sends each event only where it
+ * matters:
+ *   - pointer events to the topmost widget under the cursor, plus the
+ *     widget that captured the pointer on mouse down (drags), plus the
+ *     one hovered before (so it can clear its hover state)
+ *   - mouse down also to the previously focused widget (blur, close)
+ *   - keyboard and text input to the focused widget only
+ */
+
+#ifndef HIT_INDEX_H
+#define HIT_INDEX_H
+
+#include <stdbool.h>
+#include "backend_interface.h"
+#include "profiler.h"
+
+#define HIT_CELL_SIZE   64    // grid cell edge in physical pixels
+#define HIT_MAX_CELLS   4096  // cells grow past HIT_CELL_SIZE beyond this
+
+typedef void (*HitUpdateFn)(void* widget, axEvent* event);
+
+typedef enum {
+    HIT_MOVES_LAYOUT = 1 << 0   // its updates can move other widgets (containers)
+} HitFlags;
+
+typedef struct {
+    Rect           bounds;   // physical pixels, clipped to the parent
+    void*          widget;
+    HitUpdateFn    update;
+    axProfilePhase phase;    // profiler phase the update is timed under
+    int            flags;
+} HitEntry;
+
+// Drops the previous frame's entries
+void hit_index_begin(void);
+// Adds a widget; later calls sit above earlier ones. Empty bounds keep the
+// widget focusable without making it hittable.
+void hit_index_add(Rect bounds, void* widget, HitUpdateFn update, axProfilePhase phase, int flags);
+// Builds the grid and drops hover/capture/focus on widgets that are gone
+void hit_index_end(void);
+
+// False once the index no longer matches the layout (new frame, container
+// moved, a click ran a callback); the owner rebuilds before the next event
+bool hit_index_valid(void);
+void hit_index_invalidate(void);
+
+// Topmost entry containing (x, y), or NULL
+const HitEntry* hit_index_at(int x, int y);
+
+// Sends one event to the widgets that should see it
+void hit_index_dispatch(axEvent* event);
+
+#endif // HIT_INDEX_H
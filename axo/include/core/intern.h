@@ -0,0 +1,28 @@
+/**
+ * @file intern.h
+ * @brief Shared, immutable copies of widget labels and placeholders
+ *
+ * Strings are copied once into a chunked arena and deduplicated, so ten
+ * buttons labelled "OK" hold the same pointer and two interned strings
+ * compare equal by address. Widgets never free their labels; the whole
+ * pool is dropped at once by intern_reset when the widgets go away.
+ *
+ * The pool grows with every distinct string and never shrinks before
+ * intern_reset, so it is meant for text fixed at creation. Text that
+ * changes while the app runs belongs in axSetTextContent, which keeps it
+ * out of the pool. axRun resets the pool at shutdown; hosts that drive
+ * axRunFrame themselves call intern_reset after freeing their widgets.
+ */
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#define INTERN_CHUNK_SIZE  4096   // arena chunk size; longer strings get a chunk of their own
+
+// The interned copy of s (NULL for NULL). Stays valid until intern_reset.
+const char* intern_string(const char* s);
+
+// Frees every interned string. Only call once no widget refers to them.
+void intern_reset(void);
+
+#endif // INTERN_H
@@ -10,6 +10,17 @@
 #include <stdbool.h>
 #include "color.h"
 
+/**
+ * @brief A widget's physical rect, cached against the logical geometry and
+ *        the parent geometry generation it was computed from.
+ */
+typedef struct {
+    Rect        rect;          // Physical x, y, w, h
+    Rect        key;           // Logical x, y, w, h
+    const void* parent;
+    unsigned    parent_gen;    // 0 = never computed
+} axGeomCache;
+
 /**
  * @brief This struct represents both root windows and containers.
  *        For root windows, is_window is 1 and SDL fields in Base are initialized.
@@ -32,6 +43,14 @@ typedef struct {
     int resize_zone;           // Size of edge zone for resizing
     bool is_open;              // Is open (true for root window)
     int title_height;          // Height of title bar (0 for root window)
+    // Physical geometry, cached by parent_geometry
+    Rect phys;                 // Physical x, y, w, h (the clip rect children of a container draw into)
+    int phys_title_height;     // Physical title bar height
+    int phys_resize_zone;      // Physical resize edge
+    Rect geom_key;             // Logical x, y, w, h the cache was computed from
+    int geom_key_title, geom_key_zone;
+    float geom_key_dpi;
+    unsigned geom_gen;         // Bumped on every recompute (0 = never computed)
 }axParent;
 
 /**
@@ -47,10 +66,51 @@ float get_display_dpi(int display_index);
 
 axParent axCreateWindow(char* title, int w, int h);
 
+/**
+ * @brief Creates a root "window" that renders into an offscreen RGBA
+ *        framebuffer (see headless.h) – for tests, benchmarks and
+ *        server-side screenshots. Input comes from input_push_event.
+ * @param w The width of the framebuffer (pixels, DPI scale is 1).
+ * @param h The height of the framebuffer.
+ */
+axParent axCreateHeadlessWindow(int w, int h);
+
 /**
  * @brief Destroys the Parent struct, cleaning up SDL resources if it's a root window.
  * @param parent Pointer to the Parent to destroy.
  */
 void free_parent(axParent* parent);
 Rect get_parent_rect(const axParent *p);
+/**
+ * @brief Brings the parent's phys* fields up to date: recomputed only after
+ *        it moves, resizes, changes its title bar or DPI.
+ * @return The geometry generation; it changes whenever the fields do, so
+ *         children can tell their own cached rects are stale.
+ */
+unsigned parent_geometry(axParent *p);
+/**
+ * @brief Physical clip rect children of a container draw into, or NULL for
+ *        a root window.
+ */
+const Rect* parent_clip_rect(axParent *p);
+/**
+ * @brief Physical rect of a widget at logical (x, y, w, h) in `p`, unclipped.
+ *        Only recomputed when those or the parent's geometry change.
+ */
+const Rect* widget_geom(axGeomCache *c, axParent *p, int x, int y, int w, int h);
+/**
+ * @brief Physical bounds of a rect given in the parent's logical space (the
+ *        way widgets store x, y, w, h), clipped to the parent if it is a
+ *        container. Empty if nothing of it is visible.
+ */
+Rect widget_screen_rect(axParent *p, int x, int y, int w, int h);
+/**
+ * @brief widget_screen_rect for the widget's own geometry, through its cache.
+ */
+Rect widget_visible_rect(axGeomCache *c, axParent *p, int x, int y, int w, int h);
+/**
+ * @brief Clips a physical rect to the parent if it is a container.
+ * @return false if nothing of it is left.
+ */
+bool clip_to_parent(axParent *p, Rect *r);
 #endif /* PARENT_H */
@@ -0,0 +1,92 @@
+/**
+ * @file profiler.h
+ * @brief Opt-in frame profiler: per-phase timings of axRun, per-frame
+ *        counters and rolling p50/p99, with an optional on-screen overlay
+ *
+ * Everything is a no-op (one branch) until axProfilerEnable(true).
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+
+#define PROFILER_HISTORY 240   // frames kept for the rolling percentiles
+
+typedef enum {
+    AX_PHASE_POLL,
+    AX_PHASE_UPDATE_CONTAINERS,
+    AX_PHASE_UPDATE_RADIOS,
+    AX_PHASE_UPDATE_ENTRIES,
+    AX_PHASE_UPDATE_TEXTBOXES,
+    AX_PHASE_UPDATE_SLIDERS,
+    AX_PHASE_UPDATE_BUTTONS,
+    AX_PHASE_UPDATE_TEXTS,
+    AX_PHASE_UPDATE_DROPDOWNS,
+    AX_PHASE_UPDATE_PROGRESSBARS,
+    AX_PHASE_UPDATE_IMAGES,
+    AX_PHASE_RENDER_CONTAINERS,
+    AX_PHASE_RENDER_DROPDOWNS,
+    AX_PHASE_RENDER_RADIOS,
+    AX_PHASE_RENDER_ENTRIES,
+    AX_PHASE_RENDER_TEXTBOXES,
+    AX_PHASE_RENDER_SLIDERS,
+    AX_PHASE_RENDER_BUTTONS,
+    AX_PHASE_RENDER_TEXTS,
+    AX_PHASE_RENDER_PROGRESSBARS,
+    AX_PHASE_RENDER_IMAGES,
+    AX_PHASE_IMAGE_UPLOAD,     // decoded async images turned into textures
+    AX_PHASE_PRESENT,          // draw-list flush + present
+    AX_PHASE_FRAME,            // whole frame, wall clock
+    AX_PHASE_COUNT
+} axProfilePhase;
+
+typedef enum {
+    AX_COUNTER_DRAW_CALLS,     // SDL_RenderGeometry / RenderCopy / RenderClear
+    AX_COUNTER_TEXTURE_CREATES,
+    AX_COUNTER_RASTERIZATIONS, // glyphs and one-shot strings rendered by SDL_ttf
+    AX_COUNTER_WIDGETS_CULLED, // widgets skipped by the visibility pass
+    AX_COUNTER_MOTION_MERGED,  // mouse motion events folded into the previous one
+    AX_COUNTER_COUNT
+} axProfileCounter;
+
+typedef struct {
+    double last;               // most recent frame (ms for phases)
+    double p50;
+    double p99;
+} axProfileStats;
+
+void axProfilerEnable(bool enabled);
+bool axProfilerIsEnabled(void);
+
+// Draws a small stats panel over the UI each rendered frame
+void axProfilerSetOverlay(bool visible);
+bool axProfilerOverlayVisible(void);
+
+void axProfilerGetPhase(axProfilePhase phase, axProfileStats* out);
+void axProfilerGetCounter(axProfileCounter counter, axProfileStats* out);
+const char* axProfilerPhaseName(axProfilePhase phase);
+const char* axProfilerCounterName(axProfileCounter counter);
+
+// Clears the rolling history
+void axProfilerReset(void);
+
+/* ---------- instrumentation (library internals) ---------- */
+extern bool profiler_enabled;
+
+void profiler_begin_(axProfilePhase phase);
+void profiler_end_(axProfilePhase phase);
+void profiler_count_(axProfileCounter counter, int n);
+
+#define profiler_begin(phase)     do { if (profiler_enabled) profiler_begin_(phase); } while (0)
+#define profiler_end(phase)       do { if (profiler_enabled) profiler_end_(phase); } while (0)
+#define profiler_count(counter, n) do { if (profiler_enabled) profiler_count_(counter, n); } while (0)
+
+// Times one statement under `phase`
+#define PROFILED(phase, stmt) do { profiler_begin(phase); stmt; profiler_end(phase); } while (0)
+
+void profiler_frame_begin(void);
+// rendered = 0 drops the frame (e.g. an idle wake-up in on-demand mode)
+void profiler_frame_end(int rendered);
+
+#endif // PROFILER_H
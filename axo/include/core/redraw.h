@@ -0,0 +1,49 @@
+/**
+ * @file redraw.h
+ * @brief Damage tracking for the on-demand redraw mode of axRun
+ */
+
+#ifndef REDRAW_H
+#define REDRAW_H
+
+#include <stdbool.h>
+#include "parent.h"
+
+#define REDRAW_MAX_RECTS        8    // damage list size before it collapses to a bounding box
+#define REDRAW_IDLE_TIMEOUT_MS  250  // how long axRun sleeps in the event queue when clean
+
+typedef enum {
+    AX_REDRAW_CONTINUOUS,   // clear + render everything every loop iteration (default)
+    AX_REDRAW_ON_DEMAND     // block for events, redraw only damaged rectangles
+} axRedrawMode;
+
+void axSetRedrawMode(axRedrawMode mode);
+axRedrawMode axGetRedrawMode(void);
+
+/**
+ * @brief Marks a rectangle in physical pixels as needing a redraw.
+ *        No-op in continuous mode.
+ */
+void axInvalidateRect(Rect rect);
+
+/**
+ * @brief Marks a widget rectangle as needing a redraw.
+ * @param parent Window or container the coordinates are relative to
+ * @param x,y,w,h Logical bounds, as stored on the widget
+ */
+void axInvalidateWidget(const axParent* parent, int x, int y, int w, int h);
+
+// Marks the whole window as needing a redraw
+void axInvalidateAll(void);
+
+bool axIsDirty(void);
+
+/**
+ * @brief Hands the pending damage to the renderer and resets it.
+ * @param out Receives up to REDRAW_MAX_RECTS rectangles
+ * @param full_w,full_h Render output size, used for full invalidations
+ * @return Number of rectangles written (0 = nothing to redraw)
+ */
+int redraw_take_damage(Rect* out, int full_w, int full_h);
+
+#endif // REDRAW_H
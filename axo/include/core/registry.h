@@ -0,0 +1,86 @@
+/**
+ * @file registry.h
+ * @brief One registry for every widget type, walked in a single draw order
+ *
+ * Each widget type describes itself with an axWidgetClass (update, render,
+ * free, hit bounds). Registered widgets live in one growable array sorted
+ * by z, then registration order; that order is the paint order, and the
+ * reverse is the hit order. Handles carry a generation, so a stale handle
+ * is detected instead of reaching a reused slot.
+ */
+
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include <stdbool.h>
+#include "backend_interface.h"
+#include "profiler.h"
+
+#define AX_Z_CONTAINERS  (-1000)   // containers paint under every widget
+#define AX_Z_WIDGETS     0
+
+typedef struct {
+    const char*    name;
+    void           (*update)(void* widget, axEvent* event);
+    void           (*render)(void* widget);
+    void           (*free)(void* widget);
+    // Physical bounds for pointer input; NULL or false = takes no pointer input
+    bool           (*bounds)(void* widget, Rect* out);
+    // Physical rect it draws into, clipped to its parent; false = draws
+    // nothing. NULL = never culled.
+    bool           (*extent)(void* widget, Rect* out);
+    axProfilePhase update_phase;
+    axProfilePhase render_phase;
+    int            default_z;
+    int            hit_flags;     // HitFlags (hit_index.h)
+    // Optional: the widget just left the registry (unregistered or freed);
+    // drops whatever refers to it by pointer
+    void           (*unregistered)(void* widget);
+} axWidgetClass;
+
+typedef struct {
+    unsigned index;
+    unsigned generation;          // 0 = invalid handle
+} axWidgetHandle;
+
+typedef struct {
+    void*                widget;  // NULL once unregistered (until the next walk compacts)
+    const axWidgetClass* cls;
+    int                  z;
+    unsigned             seq;     // registration order, breaks z ties
+    unsigned             slot;
+    bool                 visible; // result of the last registry_cull
+} axWidgetEntry;
+
+axWidgetHandle axRegisterWidget(void* widget, const axWidgetClass* cls);
+// O(1); false if the handle is stale. Does not free the widget.
+bool  axUnregisterWidget(axWidgetHandle handle);
+// The widget behind a handle, or NULL if it was unregistered
+void* axGetWidget(axWidgetHandle handle);
+void  axSetWidgetZ(axWidgetHandle handle, int z);
+
+/**
+ * @brief Every registered widget in draw order. Entries whose widget is
+ *        NULL were unregistered during the walk; skip them.
+ *        Valid until the next register/unregister/z change.
+ */
+const axWidgetEntry* axGetWidgets(int* count);
+
+/**
+ * @brief Visibility pass: marks every widget whose extent misses `view`
+ *        (the window, in physical pixels) or its parent's clip as hidden,
+ *        so axRenderAllWidgets skips it until the next pass.
+ */
+void registry_cull(const Rect* view);
+// Renders visible widgets in draw order
+void axRenderAllWidgets(void);
+// Sends the event to every widget (axRun routes through the hit index instead)
+void axUpdateAllWidgets(axEvent* event);
+// Frees and unregisters every widget of a class (NULL = all classes)
+void axFreeAllWidgets(const axWidgetClass* cls);
+
+// Per-class walks, used by the axRenderAllRegistered* family
+void registry_render_class(const axWidgetClass* cls);
+void registry_update_class(const axWidgetClass* cls, axEvent* event);
+
+#endif // REGISTRY_H
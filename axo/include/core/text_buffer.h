@@ -0,0 +1,84 @@
+/**
+ * @file text_buffer.h
+ * @brief Gap buffer with an undo/redo log, used as the text storage of
+ *        axEntry and axTextBox
+ *
+ * The text lives in one allocation with a movable gap. Edits move the gap
+ * to the edit point, so typing at the cursor is amortized O(1), and the
+ * length is cached instead of recomputed with strlen.
+ */
+
+#ifndef TEXT_BUFFER_H
+#define TEXT_BUFFER_H
+
+#include <stdbool.h>
+
+#define TEXT_UNDO_DEPTH  128   // edits kept in the undo log
+
+typedef struct {
+    int   pos;                 // where the edit happened
+    char* removed;             // bytes taken out (NULL if none)
+    int   removed_len;
+    char* inserted;            // bytes put in (NULL if none)
+    int   inserted_len;
+} TextEdit;
+
+typedef struct {
+    char*     data;            // text with a gap at [gap_start, gap_end)
+    int       cap;
+    int       gap_start, gap_end;
+    int       length;          // bytes of text
+    int       max_length;      // 0 = unbounded
+    TextEdit* history;         // [0, undo_top) can be undone, [undo_top, history_count) redone
+    int       history_count;
+    int       undo_top;
+    bool      coalesce;        // the next typed edit may merge into the last one
+} TextBuffer;
+
+// What an undo/redo changed, so callers can patch caches and the caret
+typedef struct {
+    int pos;
+    int removed;               // bytes removed at pos
+    int inserted;              // bytes inserted at pos
+    int cursor;                // where the caret belongs afterwards
+} TextChange;
+
+bool text_buffer_init(TextBuffer* tb, int max_length);
+void text_buffer_free(TextBuffer* tb);
+
+/**
+ * @brief Replaces `remove_len` bytes at `pos` with `n` bytes of `s`,
+ *        recording one undo step.
+ * @return false (and changes nothing) if the result would exceed
+ *         max_length or memory ran out
+ */
+bool text_buffer_replace(TextBuffer* tb, int pos, int remove_len, const char* s, int n);
+bool text_buffer_insert(TextBuffer* tb, int pos, const char* s, int n);
+void text_buffer_erase(TextBuffer* tb, int pos, int n);
+
+// Replaces the whole text; clears the undo log
+bool text_buffer_set(TextBuffer* tb, const char* s);
+
+char text_buffer_at(const TextBuffer* tb, int i);
+
+/**
+ * @brief Pointer to text[start, start + len) laid out contiguously.
+ *        Moves the gap out of the range if needed (cost: the distance moved).
+ *        Not NUL-terminated; valid until the next edit or range call.
+ */
+const char* text_buffer_range(TextBuffer* tb, int start, int len);
+
+// The whole text as a NUL-terminated string (moves the gap to the end)
+const char* text_buffer_cstr(TextBuffer* tb);
+
+// Copies text[start, start + len) to `out` and NUL-terminates it
+void text_buffer_copy(const TextBuffer* tb, int start, int len, char* out);
+
+bool text_buffer_undo(TextBuffer* tb, TextChange* out);
+bool text_buffer_redo(TextBuffer* tb, TextChange* out);
+
+// Stops the next edit from merging into the previous undo step
+// (call on caret moves, clicks, pastes)
+void text_buffer_break_undo(TextBuffer* tb);
+
+#endif // TEXT_BUFFER_H
@@ -12,20 +12,21 @@
 #include "../core/color.h"
 #include "../core/parent.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
 
 
-#define MAX_BUTTONS 100
 
 typedef struct {
     axParent* parent;            // Pointer to the parent window or container
     int x, y;                  // Position of the button (logical)
     int w, h;                  // Width and height of the button (logical)
-    char* label;               // Button label text
+    const char* label;         // Button label text
     void (*callback)(void);    // Callback function on click
     int is_hovered;            // Is the mouse hovering over the button?
     int is_pressed;            // Is the button pressed?
-    Color* custom_bg_color;    // Optional override for bg color (NULL = use theme)
-    Color* custom_text_color;  // Optional override for text color (NULL = use theme)
+    ColorOverride custom_bg_color; // Optional override for bg color (unset = use theme)
+    ColorOverride custom_text_color; // Optional override for text color (unset = use theme)
+    axGeomCache geom;          // Cached physical rect (see widget_geom)
 }axButton;
 
 
@@ -44,10 +45,9 @@ void axFreeButton(axButton* button);
 
 // Registration
 
-extern axButton* button_widgets[MAX_BUTTONS];
-extern int buttons_count;
+extern const axWidgetClass button_class;
 
-void axRegisterButton(axButton* button);
+axWidgetHandle axRegisterButton(axButton* button);
 
 void axRenderAllRegisteredButtons(void);
 
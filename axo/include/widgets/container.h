@@ -3,6 +3,7 @@
 
 #include "../core/parent.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
 
 
 #include<SDL2/SDL.h>
@@ -17,12 +18,9 @@ void axRenderContainer(axParent* container);
 void axUpdateContainer(axParent* container, axEvent* event);
 // registering stuffs
 
-#define MAX_CONTAINERS 100
+extern const axWidgetClass container_class;
 
-extern axParent* container_widgets[MAX_CONTAINERS];
-extern int containers_count;
-
-void axRegisterContainer(axParent* container);
+axWidgetHandle axRegisterContainer(axParent* container);
 
 void axRenderAllRegisteredContainers(void);
 void axUpdateAllRegisteredContainers(axEvent* event);
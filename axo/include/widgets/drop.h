@@ -9,11 +9,19 @@
 #include "../core/parent.h"
 #include "../core/color.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
 
 
 
 #include<stdbool.h>
 
+#define DROPDOWN_MAX_VISIBLE  8    // rows the expanded list shows before it scrolls
+#define DROPDOWN_FILTER_MAX   64   // type-ahead filter length, bytes including the NUL
+#define DROPDOWN_WHEEL_ROWS   3    // rows scrolled per wheel notch
+
+// Substring index over a dropdown's options (drop.c)
+typedef struct DropIndex DropIndex;
+
 typedef struct {
     axParent* parent;         // Parent window or container
     int x, y;               // Position relative to parent (logical)
@@ -24,17 +32,23 @@ typedef struct {
     bool is_expanded;       // Whether the dropdown is open
     bool is_hovered;        // Whether mouse is over the dropdown button
     int font_size;          // Font size (overridable, defaults to theme) (logical)
-    char* place_holder;     // Placeholder text when no option is selected
-    // Theme overrides (NULL = use theme)
-    Color* custom_bg_color;       // Background for options
-    Color* custom_button_color;   // Background for dropdown button
-    Color* custom_text_color;     // Text color
-    Color* custom_highlight_color; // Highlight for selected/hovered option
+    const char* place_holder; // Placeholder text when no option is selected
+    // Theme overrides (unset = use theme)
+    ColorOverride custom_bg_color; // Background for options
+    ColorOverride custom_button_color; // Background for dropdown button
+    ColorOverride custom_text_color; // Text color
+    ColorOverride custom_highlight_color; // Highlight for selected/hovered option
+    axGeomCache geom;          // Cached physical rect (see widget_geom)
+    // Virtualized list
+    int max_visible;        // Rows shown while expanded (0 = DROPDOWN_MAX_VISIBLE)
+    int scroll;             // First row of the list in view
+    char filter[DROPDOWN_FILTER_MAX]; // Type-ahead filter typed while expanded ("" = none)
+    int filter_len;
+    DropIndex* index;       // Built on the first filter keystroke, freed by axFreeDropDown
+    bool index_failed;      // Building it ran out of memory: scan until the options change
 } axDropDown;
 
-#define MAX_DROPS 100
-extern axDropDown* drop_widgets[MAX_DROPS];
-extern int drops_count;
+extern const axWidgetClass dropdown_class;
 
 
 axDropDown axCreateDropDown(axParent* parent, int x, int y, int w, int h, char** options, int option_count);
@@ -49,13 +63,19 @@ void axSetDropDownHighlightColor(axDropDown* drop, Color color);
 
 void axSetDropDownFontSize(axDropDown* drop, int size);
 
+// Rows the expanded list shows at once; longer lists scroll
+void axSetDropDownMaxVisible(axDropDown* drop, int rows);
+// Rebuilds the filter index (retrying one that failed); call after changing
+// the options array in place
+void axDropDownOptionsChanged(axDropDown* drop);
+
 void draw_upside_down_triangle_(Base* base, int x1, int y1, int x2, int y2, int x3, int y3, Color color);
 
 void axRenderDropDown(axDropDown* drop);
 void axUpdateDropDown(axDropDown* drop, axEvent *event);
 void axFreeDropDown(axDropDown* drop);
 
-void axRegisterDropDown(axDropDown* drop);
+axWidgetHandle axRegisterDropDown(axDropDown* drop);
 
 void axRenderAllRegisteredDropDown(void);
 
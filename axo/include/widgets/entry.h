@@ -3,6 +3,8 @@
 
 #include"../core/parent.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
+#include "../core/text_buffer.h"
 
 
 #include <SDL2/SDL.h> // SDL library for handling graphics, events (e.g., SDL_Event, SDLK_* for key codes)
@@ -12,14 +14,15 @@ typedef struct {
     axParent* parent;            // Pointer to the parent window/container holding this entry
     int x, y;                  // Logical (unscaled) position of the entry relative to parent
     int w, h;                  // Logical width and height of the entry
-    char* place_holder;        // Placeholder text shown when the entry is empty
-    int max_length;            // Maximum number of characters allowed in the input
-    char* text;                // Buffer storing the user-entered text
+    const char* place_holder;  // Placeholder text shown when the entry is empty
+    int max_length;            // Maximum number of bytes allowed in the input (0 = unbounded)
+    TextBuffer text;           // User-entered text, with undo/redo
     int is_active;             // Flag indicating if the entry is currently focused (1 = active, 0 = inactive)
     int cursor_pos;            // Index of the cursor's position in the text (character index)
     int selection_start;       // Starting index of text selection (-1 if no selection)
     int visible_text_start;    // Index of the first visible character (for scrolling text)
     int is_mouse_selecting;    // Flag to track if mouse is being used to select text
+    axGeomCache geom;          // Cached physical rect (see widget_geom)
 } axEntry;
 
 
@@ -33,6 +36,12 @@ typedef struct {
 axEntry axCreateEntry(axParent* parent, int x, int y, int w, int max_length);
 
 void axSetEntryPlaceHolder(axEntry* entry, const char* placeholder);
+
+// Current text as a NUL-terminated string, valid until the next edit
+const char* axEntryGetText(axEntry* entry);
+// Replaces the text (clears undo history, moves the cursor to the end)
+void axEntrySetText(axEntry* entry, const char* text);
+
 // Renders the text entry widget to the screen
 // Parameters:
 // - entry: The Entry widget to render
@@ -55,15 +64,12 @@ void axUpdateEntry(axEntry* entry, axEvent* event);
 void axFreeEntry(axEntry* entry);
 
 // ___________________
-// Global array to store all registered entry widgets (up to MAX_ENTRYS)
-#define MAX_ENTRYS 100
-extern axEntry* entry_widgets[MAX_ENTRYS];
-extern int entrys_count; // Tracks the number of registered entries
+extern const axWidgetClass entry_class;
 
 // Registers an entry widget in the global array
 // Parameters:
 // - entry: The Entry widget to register
-void axRegisterEntry(axEntry* entry);
+axWidgetHandle axRegisterEntry(axEntry* entry);
 
 // Renders all registered entry widgets
 void axRenderAllRegisteredEntries(void);
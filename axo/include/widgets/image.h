@@ -3,17 +3,42 @@
 
 #include "../core/parent.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
 
 
 
-typedef struct{
+typedef enum {
+    AX_IMAGE_READY,
+    AX_IMAGE_LOADING,     /* decoding in the background; draws a placeholder */
+    AX_IMAGE_FAILED
+} axImageState;
+
+typedef struct axImage axImage;
+
+/* Called once, from the frame that uploads the texture (or gives up) */
+typedef void (*axImageLoadFn)(axImage* image, bool ok, void* user_data);
+
+struct axImage {
    axParent*      parent;
     int          x, y, w, h;          /* logical coordinates */
     const char*  file_path;
     ImageHandle* handle;              /* opaque backend handle */
-}axImage;
+    axGeomCache  geom;                /* cached physical rect */
+    axImageState  state;
+    axImageLoadFn on_load;
+    void*         user_data;
+};
 
 axImage axCreateImage(axParent * parent, int x, int y, const char * file_path, int w, int h  );
+// Embedded asset; the bytes are decoded (or found in the cache) right away
+axImage axCreateImageFromMemory(axParent * parent, int x, int y, const void * data, size_t size, int w, int h);
+// Returns at once and decodes on a worker thread; the image is
+// AX_IMAGE_LOADING until a later frame uploads it
+axImage axCreateImageAsync(axParent * parent, int x, int y, const char * file_path, int w, int h);
+
+// Not called for images that were already loaded (or failed) when created
+void axSetImageLoadCallback(axImage *image, axImageLoadFn fn, void *user_data);
+axImageState axGetImageState(axImage *image);
 
 void axRenderImage(axImage * image);
 
@@ -21,13 +46,9 @@ void axUpdateImage(axImage *image, axEvent *event);
 void axFreeImage(axImage *image);
 
 
-// Registration of widgets for rendering
-#define MAX_IMAGES 100
-extern axImage * image_widgets[MAX_IMAGES];
-
-extern int images_count;
+extern const axWidgetClass image_class;
 
-void axRegisterImage(axImage* image);
+axWidgetHandle axRegisterImage(axImage* image);
 
 void axRenderAllRegisteredImages(void);
 
@@ -35,4 +56,7 @@ void axUpdateAllRegisteredImages(axEvent* event);
 
 void axFreeAllRegisteredImages(void);
 
+// Moves registered images whose load finished out of AX_IMAGE_LOADING
+void image_sync_loads(void);
+
 #endif // IMAGE_H
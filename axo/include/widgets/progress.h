@@ -9,6 +9,7 @@
 #include "../core/parent.h"
 #include "../core/color.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
 
 
 #include <stdbool.h>
@@ -20,9 +21,10 @@ typedef struct {
     int min, max;              // Range (default 0-100)
     int value;                 // Current value (clamped between min and max)
     bool show_percentage;      // Whether to display percentage text
-    Color* custom_bg_color;    // Optional override for background color (NULL = use theme)
-    Color* custom_fill_color;  // Optional override for fill color (NULL = use theme)
-    Color* custom_text_color;  // Optional override for text color (NULL = use theme)
+    ColorOverride custom_bg_color; // Optional override for background color (unset = use theme)
+    ColorOverride custom_fill_color; // Optional override for fill color (unset = use theme)
+    ColorOverride custom_text_color; // Optional override for text color (unset = use theme)
+    axGeomCache geom;          // Cached physical rect (see widget_geom)
 } axProgressBar;
 
 
@@ -47,12 +49,10 @@ void axUpdateProgressBar(axProgressBar* progress_bar, axEvent* event);
 void axFreeProgressBar(axProgressBar* progress_bar);
 
 
-#define MAX_PROGRESS_BARS 100
-extern axProgressBar* progress_bar_widgets[MAX_PROGRESS_BARS];
-extern int progress_bars_count;
+extern const axWidgetClass progress_bar_class;
 
 // -------- Helpers for all Progress Bars --------
-void axRegisterProgressBar(axProgressBar* progress_bar);
+axWidgetHandle axRegisterProgressBar(axProgressBar* progress_bar);
 
 void axRenderAllRegisteredProgressBars(void);
 
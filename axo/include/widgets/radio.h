@@ -9,6 +9,7 @@
 #include "../core/parent.h"
 #include "../core/color.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
 
 
 #include <stdbool.h>
@@ -18,14 +19,17 @@ typedef struct {
     axParent* parent;      // Parent container or window
     int x, y;            // Position (relative to parent) (logical)
     int w, h;            // Size (logical)
-    char* label;         // Label text
+    const char* label;   // Label text
     bool selected;       // Is selected?
     int group_id;        // Group ID (1 group → only 1 selected)
     bool is_hovered;     // For potential hover effects
-    // Theme overrides (NULL = use theme)
-    Color* custom_outer_color;   // Outer circle color
-    Color* custom_inner_color;   // Inner circle color when selected
-    Color* custom_label_color;   // Label text color
+    // Theme overrides (unset = use theme)
+    ColorOverride custom_outer_color; // Outer circle color
+    ColorOverride custom_inner_color; // Inner circle color when selected
+    ColorOverride custom_label_color; // Label text color
+    axGeomCache geom;          // Cached physical rect (see widget_geom)
+    axGeomCache hit_geom;      // Same for the pointer bounds, which differ
+    int group_pos;             // 1 + index among its group's members, 0 = in none
 } axRadioButton;
 
 
@@ -40,17 +44,33 @@ void axSetRadioButtonLabelColor(axRadioButton* radio, Color color);
 // -------- Render --------
 void axRenderRadioButton(axRadioButton* radio);
 
-#define MAX_RADIOS 100
-extern axRadioButton* radio_widgets[MAX_RADIOS];
-extern int radios_count;
+extern const axWidgetClass radio_class;
 
 // -------- Update --------
 void axUpdateRadioButton(axRadioButton* radio, axEvent *event);
 // -------- Free --------
+// Also takes the radio out of its group
 void axFreeRadioButton(axRadioButton* radio);
 
 // -------- Register --------
-void axRegisterRadioButton(axRadioButton* radio);
+// Registering also adds the radio to the group table under its group_id
+axWidgetHandle axRegisterRadioButton(axRadioButton* radio);
+
+// -------- Groups --------
+// Called after the selection of a group changes
+typedef void (*axRadioChangeFn)(int group_id, axRadioButton* selected);
+
+// Selected member of a group, or NULL
+axRadioButton* axGetSelectedRadio(int group_id);
+// Registered members of a group, in no particular order. Valid until a
+// member joins or leaves the group.
+axRadioButton* const* axGetRadioGroup(int group_id, int* count);
+// Selects a registered radio and clears the previously selected member;
+// an unregistered one is only marked selected
+void axSelectRadioButton(axRadioButton* radio);
+void axSetRadioGroupCallback(int group_id, axRadioChangeFn on_change);
+// Drops every group and its callback; only call once no radio is registered
+void radio_groups_reset(void);
 
 // -------- Helpers for all radios --------
 void axRenderAllRegisteredRadioButtons(void);
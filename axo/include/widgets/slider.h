@@ -4,6 +4,7 @@
 #include "../core/parent.h"
 #include "../core/color.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
 
 
 #include <stdbool.h>
@@ -14,12 +15,14 @@ typedef struct {
     int w, h;            // Width and height (assume horizontal slider, w > h) (logical)
     int min, max;        // Range of values
     int value;           // Current value
-    char* label;         // Optional label text
+    const char* label;   // Optional label text
     bool dragging;       // Flag to track if thumb is being dragged
     bool is_hovered;     // Flag for hover state (for color variants)
-    Color* custom_track_color;   // Optional override for track color (NULL = use theme)
-    Color* custom_thumb_color;   // Optional override for thumb color (NULL = use theme)
-    Color* custom_label_color;   // Optional override for label color (NULL = use theme)
+    ColorOverride custom_track_color; // Optional override for track color (unset = use theme)
+    ColorOverride custom_thumb_color; // Optional override for thumb color (unset = use theme)
+    ColorOverride custom_label_color; // Optional override for label color (unset = use theme)
+    axGeomCache geom;          // Cached physical rect (see widget_geom)
+    axGeomCache hit_geom;      // Same for the pointer bounds, which differ
 } axSlider;
 
 
@@ -42,12 +45,10 @@ void axUpdateSlider(axSlider* slider, axEvent *event);
 void axFreeSlider(axSlider* slider);
 
 
-#define MAX_SLIDERS 100
-extern axSlider* sliders[MAX_SLIDERS];
-extern int sliders_count;
+extern const axWidgetClass slider_class;
 
 // -------- Register --------
-void axRegisterSlider(axSlider* slider);
+axWidgetHandle axRegisterSlider(axSlider* slider);
 
 // -------- Helpers for all Sliders --------
 void axRenderAllRegisteredSliders(void);
@@ -7,7 +7,9 @@
 #define TEXT_H
 
 #include "../core/parent.h"
+#include "../core/color.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
 
 
 
@@ -17,29 +19,33 @@
 typedef struct {
     axParent* parent;            // Pointer to the parent window or container
     int x, y;                  // Position of the text
-    char* content;             // Text content
+    const char* content;       // Text content (interned, or `owned` once changed)
+    char* owned;               // Buffer axSetTextContent reuses; NULL until then
+    int owned_cap;
     int font_size;             // Font size in points
-    Color* color;               // Text color
+    ColorOverride color;        // Text color (unset = use theme)
     TextAlign align;           // Alignment (LEFT, CENTER, RIGHT)
+    axGeomCache geom;          // Cached physical rect (see widget_geom)
 } axText;
 
 axText axCreateText(axParent* parent, int x, int y, const char* content, int font_size, TextAlign align);
 void axRenderText(axText* text);
 // Setters for overrides
 void axSetTextColor(axText* text, Color color);
+// For text that changes at runtime (counters, clocks, status lines): kept
+// in a buffer of the widget's own instead of the intern pool, which only
+// grows
+void axSetTextContent(axText* text, const char* content);
 
 void axUpdateText(axText* text, axEvent *event);
 
 void axFreeText(axText *text);
 
 
-// Registration
-#define MAX_TEXTS 100
 
-extern axText* text_widgets[MAX_TEXTS];
-extern int texts_count;
+extern const axWidgetClass text_class;
 
-void axRegisterText(axText* text);
+axWidgetHandle axRegisterText(axText* text);
 
 void axRenderAllRegisteredTexts(void);
 
@@ -3,6 +3,8 @@
 
 #include "../core/parent.h"
 #include "../core/backend_interface.h"
+#include "../core/registry.h"
+#include "../core/text_buffer.h"
 
 
 typedef struct {
@@ -12,24 +14,42 @@ typedef struct {
 
 Line* compute_visual_lines(const char* text, int max_width, Font_ttf* font, int* num_lines);
 
+// Persistent wrap of a textbox's text. Edits re-wrap only the paragraphs
+// they touch; a change of wrap width, font or text length rebuilds it.
+typedef struct {
+    Line* lines;               // Visual lines in text order
+    int count, cap;
+    int width;                 // Wrap width it was built for (physical px)
+    Font_ttf* font;            // Font it was measured with
+    int text_len;              // strlen(text) it describes
+    int valid;
+} WrapIndex;
+
 typedef struct {
     axParent* parent;            // Pointer to the parent window or container
     int x, y;                  // Position of the textbox (logical)
     int w, h;                  // Width and height of the textbox (logical, taller by default)
-    char* place_holder;        // Placeholder text
-    int max_length;            // Maximum text length
-    char* text;                // Input text (supports \n for lines)
+    const char* place_holder;  // Placeholder text
+    int max_length;            // Maximum text length (bytes, 0 = unbounded)
+    TextBuffer text;           // Input text (supports \n for lines), with undo/redo
     int is_active;             // Is the textbox active?
     int cursor_pos;            // Cursor position (character index)
     int selection_start;       // Selection anchor (-1 if no selection)
     int visible_line_start;    // Index of first visible line
     int line_height;           // Height of each line (logical, computed from font)
     int is_mouse_selecting;    // Flag to track if mouse is being used to select text
+    WrapIndex wrap;            // Line-wrap index driving render, cursor movement and hit-testing
+    axGeomCache geom;          // Cached physical rect (see widget_geom)
 } axTextBox;
 
 
 axTextBox axCreateTextBox(axParent* parent, int x, int y, int w, int max_length);
 
+// Current text as a NUL-terminated string, valid until the next edit
+const char* axTextBoxGetText(axTextBox* textbox);
+// Replaces the text (clears undo history, moves the cursor to the end)
+void axTextBoxSetText(axTextBox* textbox, const char* text);
+
 // Renders the textbox widget to the screen
 // Parameters:
 // - textbox: The TextBox widget to render
@@ -47,13 +67,10 @@ void axUpdateTextBox(axTextBox* textbox, axEvent *event);
 
 void axFreeTextBox(axTextBox* textbox);
 
-// Registration
-#define MAX_TEXTBOXS 100
 
-extern axTextBox* textbox_widgets[MAX_TEXTBOXS];
-extern int textboxs_count;
+extern const axWidgetClass textbox_class;
 
-void axRegisterTextBox(axTextBox* textbox);
+axWidgetHandle axRegisterTextBox(axTextBox* textbox);
 
 void axRenderAllRegisteredTextBoxes(void);
 
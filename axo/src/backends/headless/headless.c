@@ -0,0 +1,92 @@
+#include "../../../include/backends/headless/headless.h"
+#include "../../../include/backends/sdl2/sdl2_batch.h"
+#include "../../../include/backends/sdl2/sdl2_events.h"
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+
+// The surface behind the single headless renderer
+static struct {
+    SDL_Renderer *ren;
+    SDL_Surface  *surface;
+} framebuffer = {0};
+
+int headless_create(Base *base, int w, int h)
+{
+    base->sdl_window   = NULL;
+    base->sdl_renderer = NULL;
+    base->dpi_scale    = 1.0f;
+
+    // No display on build agents: never let SDL go looking for one
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_EVENTS) < 0) {
+        printf("SDL initialization failed: %s\n", SDL_GetError());
+        return 0;
+    }
+    if (!TTF_WasInit() && TTF_Init() == -1) {
+        printf("TTF initialization failed: %s\n", TTF_GetError());
+        SDL_Quit();
+        return 0;
+    }
+
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        printf("Framebuffer creation failed: %s\n", SDL_GetError());
+        TTF_Quit();
+        SDL_Quit();
+        return 0;
+    }
+
+    SDL_Renderer *ren = SDL_CreateSoftwareRenderer(surface);
+    if (!ren) {
+        printf("Software renderer creation failed: %s\n", SDL_GetError());
+        SDL_FreeSurface(surface);
+        TTF_Quit();
+        SDL_Quit();
+        return 0;
+    }
+
+    framebuffer.ren = ren;
+    framebuffer.surface = surface;
+    base->sdl_renderer = ren;
+    input_set_virtual_mouse(true);
+    return 1;
+}
+
+void headless_destroy(Base *base)
+{
+    SDL_Surface *surface = (base->sdl_renderer == framebuffer.ren) ? framebuffer.surface : NULL;
+
+    destroy_window(base);   // renderer, caches, fonts, SDL
+
+    // The software renderer draws into the surface but does not own it
+    if (surface) {
+        SDL_FreeSurface(surface);
+        framebuffer.ren = NULL;
+        framebuffer.surface = NULL;
+    }
+    input_set_virtual_mouse(false);
+}
+
+const Uint8* headless_pixels(Base *base, int *w, int *h, int *pitch)
+{
+    if (!base || !base->sdl_renderer || base->sdl_renderer != framebuffer.ren) return NULL;
+
+    batch_flush();
+    SDL_Surface *s = framebuffer.surface;
+    if (w) *w = s->w;
+    if (h) *h = s->h;
+    if (pitch) *pitch = s->pitch;
+    return (const Uint8*)s->pixels;
+}
+
+int headless_save_png(Base *base, const char *path)
+{
+    if (!headless_pixels(base, NULL, NULL, NULL)) return 0;
+
+    if (IMG_SavePNG(framebuffer.surface, path) != 0) {
+        printf("Failed to save %s: %s\n", path, IMG_GetError());
+        return 0;
+    }
+    return 1;
+}
@@ -1,4 +1,9 @@
 #include "../../../include/backends/sdl2/sdl2.h"
+#include "../../../include/core/profiler.h"
+#include "../../../include/backends/sdl2/sdl2_ttf.h"
+#include "../../../include/backends/sdl2/sdl2_draw.h"
+#include "../../../include/backends/sdl2/sdl2_batch.h"
+#include "../../../include/backends/sdl2/sdl2_image.h"
 #include<SDL2/SDL_image.h>
 #include<SDL2/SDL_ttf.h>
 // Returns DPI scale relative to standard 96 DPI
@@ -33,7 +38,7 @@ void create_window(Base *base, char* title, int w, int h) {
         return;  // Early exit on failure
     }
 
-    if (TTF_Init() == -1) {
+    if (!TTF_WasInit() && TTF_Init() == -1) {   // the font registry may have started it
         printf("TTF initialization failed: %s\n", TTF_GetError());
         SDL_Quit();
         return;
@@ -73,8 +78,24 @@ void create_window(Base *base, char* title, int w, int h) {
     // base->dpi_scale = return_display_dpi(0);
 }
 
+static struct {
+    SDL_Renderer *ren;
+    SDL_Texture  *tex;
+    int           w, h;
+} backbuffer = {0};
+
 void destroy_window(Base *base) {
     if (base->sdl_renderer) {
+        batch_flush();
+        ttf_release_renderer(base->sdl_renderer);  // atlas pages die with the renderer
+        draw_release_renderer(base->sdl_renderer);
+        image_async_shutdown();   // join the decoders before SDL goes away
+        image_release_renderer(base->sdl_renderer);
+        if (backbuffer.ren == base->sdl_renderer) {
+            SDL_DestroyTexture(backbuffer.tex);
+            backbuffer.ren = NULL;
+            backbuffer.tex = NULL;
+        }
         SDL_DestroyRenderer(base->sdl_renderer);
         base->sdl_renderer = NULL;  // Null out to avoid double-free
     }
@@ -82,49 +103,151 @@ void destroy_window(Base *base) {
         SDL_DestroyWindow(base->sdl_window);
         base->sdl_window = NULL;
     }
+    font_registry_clear();
     IMG_Quit();
     TTF_Quit();
     SDL_Quit();
 }
 
-static struct {
+typedef struct {
     SDL_bool enabled;
     SDL_Rect rect;
-} saved_clip = {0};
+} ClipState;
 
-void clip_begin(Base *base, const Rect *rect)
+// Each level holds the effective clip (already intersected with the levels
+// below and the damage area), so popping is a plain restore
+static struct {
+    ClipState level[CLIP_STACK_DEPTH];
+    int       depth;
+    int       overflow;   // pushes past CLIP_STACK_DEPTH that were not stored
+} clip_stack = {0};
+
+static ClipState damage_clip = {0};
+
+// Keeps the renderer and the draw list clipped the same way
+static void apply_clip(SDL_Renderer *ren, const SDL_Rect *r)
 {
-    if (!base || !base->sdl_renderer) return;
+    batch_set_clip(r);
+    SDL_RenderSetClipRect(ren, r);
+}
 
-    SDL_Renderer *ren = base->sdl_renderer;
+static const ClipState *active_clip(void)
+{
+    return clip_stack.depth > 0 ? &clip_stack.level[clip_stack.depth - 1] : &damage_clip;
+}
 
-    // Save current
-    saved_clip.enabled = SDL_RenderIsClipEnabled(ren);
-    if (saved_clip.enabled) {
-        SDL_RenderGetClipRect(ren, &saved_clip.rect);
-    }
+static void apply_state(SDL_Renderer *ren, const ClipState *c)
+{
+    apply_clip(ren, c->enabled ? &c->rect : NULL);
+}
+
+void clip_begin(Base *base, const Rect *rect)
+{
+    if (!base || !base->sdl_renderer) return;
 
-    // Set new
+    ClipState next = *active_clip();
     if (rect) {
         SDL_Rect r = { rect->x, rect->y, rect->w, rect->h };
-        SDL_RenderSetClipRect(ren, &r);
+        if (next.enabled && !SDL_IntersectRect(&r, &next.rect, &r)) {
+            r.w = r.h = 0;
+        }
+        next.enabled = SDL_TRUE;
+        next.rect = r;
+    }
+
+    if (clip_stack.depth < CLIP_STACK_DEPTH) {
+        clip_stack.level[clip_stack.depth++] = next;
     } else {
-        SDL_RenderSetClipRect(ren, NULL);
+        clip_stack.overflow++;
     }
+    apply_state(base->sdl_renderer, &next);
 }
 
 void clip_end(Base *base)
 {
     if (!base || !base->sdl_renderer) return;
 
-    SDL_Renderer *ren = base->sdl_renderer;
+    if (clip_stack.overflow > 0) {
+        clip_stack.overflow--;
+    } else if (clip_stack.depth > 0) {
+        clip_stack.depth--;
+    }
+    apply_state(base->sdl_renderer, active_clip());
+}
+
+int clip_visible(Base *base, const Rect *rect)
+{
+    (void)base;   // same signature as clip_begin/clip_end
+    if (!rect || rect->w <= 0 || rect->h <= 0) return 0;
+    const ClipState *c = active_clip();
+    if (!c->enabled) return 1;
+    SDL_Rect r = { rect->x, rect->y, rect->w, rect->h };
+    return SDL_HasIntersection(&r, &c->rect) == SDL_TRUE;
+}
+
+void get_render_size(Base *base, int *w, int *h)
+{
+    int rw = 0, rh = 0;
+    if (base && base->sdl_renderer) SDL_GetRendererOutputSize(base->sdl_renderer, &rw, &rh);
+    if (w) *w = rw;
+    if (h) *h = rh;
+}
 
-    if (saved_clip.enabled) {
-        SDL_RenderSetClipRect(ren, &saved_clip.rect);
+void set_damage_clip(Base *base, const Rect *rect)
+{
+    if (!base || !base->sdl_renderer) return;
+
+    // A new pass starts with nothing pushed
+    clip_stack.depth = clip_stack.overflow = 0;
+    if (rect) {
+        damage_clip.enabled = SDL_TRUE;
+        damage_clip.rect = (SDL_Rect){ rect->x, rect->y, rect->w, rect->h };
+        apply_clip(base->sdl_renderer, &damage_clip.rect);
     } else {
-        SDL_RenderSetClipRect(ren, NULL);
+        damage_clip.enabled = SDL_FALSE;
+        apply_clip(base->sdl_renderer, NULL);
     }
 }
+
+int backbuffer_begin(Base *base)
+{
+    if (!base || !base->sdl_renderer) return 0;
+
+    SDL_Renderer *ren = base->sdl_renderer;
+    if (!SDL_RenderTargetSupported(ren)) return 0;
+    batch_flush();   // anything pending belongs to the previous target
+
+    int w, h, fresh = 0;
+    get_render_size(base, &w, &h);
+    if (backbuffer.ren != ren || backbuffer.w != w || backbuffer.h != h || !backbuffer.tex) {
+        if (backbuffer.tex && backbuffer.ren == ren) SDL_DestroyTexture(backbuffer.tex);
+        backbuffer.tex = SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888,
+                                           SDL_TEXTUREACCESS_TARGET, w, h);
+        profiler_count(AX_COUNTER_TEXTURE_CREATES, 1);
+        backbuffer.ren = backbuffer.tex ? ren : NULL;
+        backbuffer.w = w;
+        backbuffer.h = h;
+        if (!backbuffer.tex) return 0;
+        fresh = 1;
+    }
+
+    if (SDL_SetRenderTarget(ren, backbuffer.tex) != 0) return 0;
+    return fresh ? 2 : 1;
+}
+
+void backbuffer_present(Base *base)
+{
+    if (!base || !base->sdl_renderer || backbuffer.ren != base->sdl_renderer) return;
+
+    SDL_Renderer *ren = base->sdl_renderer;
+    batch_flush();
+    SDL_SetRenderTarget(ren, NULL);
+    apply_clip(ren, NULL);
+    SDL_RenderCopy(ren, backbuffer.tex, NULL, NULL);
+    profiler_count(AX_COUNTER_DRAW_CALLS, 1);
+    SDL_RenderPresent(ren);
+}
+
 int rect_intersect(const Rect *a, const Rect *b, Rect *result)
 {
     if (!a || !b || !result) return 0;
@@ -0,0 +1,278 @@
+#include "../../../include/backends/sdl2/sdl2_batch.h"
+#include "../../../include/core/profiler.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    SDL_Texture* tex;
+    SDL_bool     clipped;
+    SDL_Rect     clip;
+    float        x0, y0, x1, y1;     // bounds of everything recorded into it
+    int*         indices;            // kept across flushes to avoid reallocs
+    int          index_count;
+    int          index_cap;
+} BatchCmd;
+
+static struct {
+    SDL_Renderer* ren;
+    SDL_Vertex*   verts;
+    int           vert_count;
+    int           vert_cap;
+    BatchCmd*     cmds;
+    int           cmd_count;
+    int           cmd_cap;
+    SDL_bool      clipped;           // state for the next primitive
+    SDL_Rect      clip;
+    BatchStats    stats;
+} batch = {0};
+
+/* ---------- helpers ---------- */
+static int same_state(const BatchCmd* c, SDL_Texture* tex)
+{
+    if (c->tex != tex || c->clipped != batch.clipped) return 0;
+    if (!c->clipped) return 1;
+    return c->clip.x == batch.clip.x && c->clip.y == batch.clip.y &&
+           c->clip.w == batch.clip.w && c->clip.h == batch.clip.h;
+}
+
+static int bounds_overlap(const BatchCmd* c, float x0, float y0, float x1, float y1)
+{
+    return x0 < c->x1 && c->x0 < x1 && y0 < c->y1 && c->y0 < y1;
+}
+
+static int reserve_verts(int extra)
+{
+    int need = batch.vert_count + extra;
+    if (need <= batch.vert_cap) return 1;
+    int cap = batch.vert_cap ? batch.vert_cap : 1024;
+    while (cap < need) cap *= 2;
+    SDL_Vertex* v = realloc(batch.verts, sizeof(SDL_Vertex) * cap);
+    if (!v) return 0;
+    batch.verts = v;
+    batch.vert_cap = cap;
+    return 1;
+}
+
+static int reserve_indices(BatchCmd* c, int extra)
+{
+    int need = c->index_count + extra;
+    if (need <= c->index_cap) return 1;
+    int cap = c->index_cap ? c->index_cap : 256;
+    while (cap < need) cap *= 2;
+    int* idx = realloc(c->indices, sizeof(int) * cap);
+    if (!idx) return 0;
+    c->indices = idx;
+    c->index_cap = cap;
+    return 1;
+}
+
+static BatchCmd* new_cmd(SDL_Texture* tex)
+{
+    if (batch.cmd_count == batch.cmd_cap) {
+        int cap = batch.cmd_cap ? batch.cmd_cap * 2 : 64;
+        BatchCmd* c = realloc(batch.cmds, sizeof(BatchCmd) * cap);
+        if (!c) return NULL;
+        memset(c + batch.cmd_cap, 0, sizeof(BatchCmd) * (cap - batch.cmd_cap));
+        batch.cmds = c;
+        batch.cmd_cap = cap;
+    }
+    BatchCmd* c = &batch.cmds[batch.cmd_count++];
+    c->tex = tex;
+    c->clipped = batch.clipped;
+    c->clip = batch.clip;
+    c->x0 = c->y0 = 1e30f;
+    c->x1 = c->y1 = -1e30f;
+    c->index_count = 0;
+    return c;
+}
+
+// Command the next primitive should join, walking back past commands
+// it does not overlap; a new one if no compatible command is reachable
+static BatchCmd* find_cmd(SDL_Texture* tex, float x0, float y0, float x1, float y1)
+{
+    int stop = batch.cmd_count - BATCH_LOOKBACK;
+    if (stop < 0) stop = 0;
+    for (int i = batch.cmd_count - 1; i >= stop; --i) {
+        BatchCmd* c = &batch.cmds[i];
+        if (same_state(c, tex)) return c;
+        if (bounds_overlap(c, x0, y0, x1, y1)) break;
+    }
+    return new_cmd(tex);
+}
+
+/* ---------- recording ---------- */
+void batch_geometry(SDL_Renderer* ren, SDL_Texture* tex,
+                    const SDL_Vertex* verts, int vert_count,
+                    const int* indices, int index_count)
+{
+    if (!ren || !verts || vert_count <= 0 || index_count <= 0) return;
+
+    if (batch.ren != ren) {
+        batch_flush();
+        batch.ren = ren;
+    }
+    if (batch.vert_count + vert_count > BATCH_MAX_VERTS) batch_flush();
+
+    float x0 = verts[0].position.x, x1 = x0;
+    float y0 = verts[0].position.y, y1 = y0;
+    for (int i = 1; i < vert_count; ++i) {
+        const SDL_FPoint* p = &verts[i].position;
+        if (p->x < x0) x0 = p->x;
+        if (p->x > x1) x1 = p->x;
+        if (p->y < y0) y0 = p->y;
+        if (p->y > y1) y1 = p->y;
+    }
+
+    BatchCmd* c = find_cmd(tex, x0, y0, x1, y1);
+    if (!c || !reserve_verts(vert_count) || !reserve_indices(c, index_count)) return;
+
+    int base = batch.vert_count;
+    memcpy(batch.verts + base, verts, sizeof(SDL_Vertex) * vert_count);
+    batch.vert_count += vert_count;
+
+    int* out = c->indices + c->index_count;
+    if (indices) {
+        for (int i = 0; i < index_count; ++i) out[i] = base + indices[i];
+    } else {
+        for (int i = 0; i < index_count; ++i) out[i] = base + i;
+    }
+    c->index_count += index_count;
+
+    if (x0 < c->x0) c->x0 = x0;
+    if (y0 < c->y0) c->y0 = y0;
+    if (x1 > c->x1) c->x1 = x1;
+    if (y1 > c->y1) c->y1 = y1;
+    batch.stats.ops++;
+}
+
+static const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+void batch_rect(SDL_Renderer* ren, float x, float y, float w, float h, SDL_Color color)
+{
+    if (w <= 0 || h <= 0) return;
+    SDL_Vertex v[4] = {
+        { { x,     y     }, color, { 0, 0 } },
+        { { x + w, y     }, color, { 0, 0 } },
+        { { x + w, y + h }, color, { 0, 0 } },
+        { { x,     y + h }, color, { 0, 0 } },
+    };
+    batch_geometry(ren, NULL, v, 4, quad_indices, 6);
+}
+
+#define RECTS_PER_CHUNK 32
+
+void batch_rects(SDL_Renderer* ren, const SDL_Rect* rects, int count, SDL_Color color)
+{
+    // One primitive per chunk so a whole rounded rect merges as a unit
+    SDL_Vertex v[RECTS_PER_CHUNK * 4];
+    int idx[RECTS_PER_CHUNK * 6];
+
+    while (count > 0) {
+        int n = 0;
+        while (n < RECTS_PER_CHUNK && n < count) {
+            const SDL_Rect* r = &rects[n];
+            float x = (float)r->x, y = (float)r->y;
+            float x2 = x + r->w, y2 = y + r->h;
+            v[n * 4 + 0] = (SDL_Vertex){ { x,  y  }, color, { 0, 0 } };
+            v[n * 4 + 1] = (SDL_Vertex){ { x2, y  }, color, { 0, 0 } };
+            v[n * 4 + 2] = (SDL_Vertex){ { x2, y2 }, color, { 0, 0 } };
+            v[n * 4 + 3] = (SDL_Vertex){ { x,  y2 }, color, { 0, 0 } };
+            for (int k = 0; k < 6; ++k) idx[n * 6 + k] = n * 4 + quad_indices[k];
+            ++n;
+        }
+        batch_geometry(ren, NULL, v, n * 4, idx, n * 6);
+        rects += n;
+        count -= n;
+    }
+}
+
+void batch_triangle(SDL_Renderer* ren, float x1, float y1, float x2, float y2,
+                    float x3, float y3, SDL_Color color)
+{
+    SDL_Vertex v[3] = {
+        { { x1, y1 }, color, { 0, 0 } },
+        { { x2, y2 }, color, { 0, 0 } },
+        { { x3, y3 }, color, { 0, 0 } },
+    };
+    batch_geometry(ren, NULL, v, 3, NULL, 3);
+}
+
+void batch_texture(SDL_Renderer* ren, SDL_Texture* tex, const SDL_Rect* src,
+                   const SDL_Rect* dst, SDL_Color tint)
+{
+    if (!tex || !dst) return;
+
+    float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+    if (src) {
+        int tw, th;
+        if (SDL_QueryTexture(tex, NULL, NULL, &tw, &th) != 0 || tw <= 0 || th <= 0) return;
+        u0 = (float)src->x / tw;             v0 = (float)src->y / th;
+        u1 = (float)(src->x + src->w) / tw;  v1 = (float)(src->y + src->h) / th;
+    }
+
+    float x = (float)dst->x, y = (float)dst->y;
+    float x2 = x + dst->w, y2 = y + dst->h;
+    SDL_Vertex v[4] = {
+        { { x,  y  }, tint, { u0, v0 } },
+        { { x2, y  }, tint, { u1, v0 } },
+        { { x2, y2 }, tint, { u1, v1 } },
+        { { x,  y2 }, tint, { u0, v1 } },
+    };
+    batch_geometry(ren, tex, v, 4, quad_indices, 6);
+}
+
+void batch_set_clip(const SDL_Rect* clip)
+{
+    if (clip) {
+        batch.clipped = SDL_TRUE;
+        batch.clip = *clip;
+    } else {
+        batch.clipped = SDL_FALSE;
+    }
+}
+
+/* ---------- submission ---------- */
+void batch_flush(void)
+{
+    if (!batch.ren || batch.cmd_count == 0) {
+        batch.vert_count = 0;
+        batch.cmd_count = 0;
+        return;
+    }
+
+    SDL_Renderer* ren = batch.ren;
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+
+    const BatchCmd* applied = NULL;
+    for (int i = 0; i < batch.cmd_count; ++i) {
+        const BatchCmd* c = &batch.cmds[i];
+        if (c->index_count == 0) continue;
+
+        int clip_changed = !applied || applied->clipped != c->clipped ||
+                           (c->clipped && memcmp(&applied->clip, &c->clip, sizeof(SDL_Rect)) != 0);
+        if (clip_changed) SDL_RenderSetClipRect(ren, c->clipped ? &c->clip : NULL);
+        applied = c;
+
+        SDL_RenderGeometry(ren, c->tex, batch.verts, batch.vert_count,
+                           c->indices, c->index_count);
+        profiler_count(AX_COUNTER_DRAW_CALLS, 1);
+        batch.stats.draw_calls++;
+    }
+
+    // Leave the renderer clipped the way the recorder currently expects
+    SDL_RenderSetClipRect(ren, batch.clipped ? &batch.clip : NULL);
+
+    batch.stats.flushes++;
+    batch.vert_count = 0;
+    batch.cmd_count = 0;
+}
+
+void batch_get_stats(BatchStats* out)
+{
+    if (out) *out = batch.stats;
+}
+
+void batch_reset_stats(void)
+{
+    memset(&batch.stats, 0, sizeof batch.stats);
+}
@@ -1,201 +1,328 @@
 #include "../../../include/backends/sdl2/sdl2_draw.h"
+#include "../../../include/core/profiler.h"
+#include "../../../include/backends/sdl2/sdl2_batch.h"
+#include "../../../include/backends/sdl2/sdl2_image.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <math.h>
 
+static SDL_Color to_sdl(Color c) {
+    return (SDL_Color){ c.r, c.g, c.b, c.a };
+}
+
 void clear_screen(Base* base, Color color) {
+    batch_flush();   // RenderClear ignores the draw list
     SDL_SetRenderDrawColor(base->sdl_renderer, color.r, color.g, color.b, color.a);
     SDL_RenderClear(base->sdl_renderer);
+    profiler_count(AX_COUNTER_DRAW_CALLS, 1);
 }
 
 void present_screen(Base* base) {
+    batch_flush();
     SDL_RenderPresent(base->sdl_renderer);
 }
 
 // ______________DRAW FUNCTIONS_____________
 
 void draw_rect(Base* base, int x, int y, int w, int h, Color color) {
-    SDL_SetRenderDrawColor(base->sdl_renderer, color.r, color.g, color.b, color.a);
-    SDL_Rect rect = {x, y, w, h};
-    SDL_RenderFillRect(base->sdl_renderer, &rect);
+    batch_rect(base->sdl_renderer, (float)x, (float)y, (float)w, (float)h, to_sdl(color));
 }
 
-void draw_circle(Base* base, int x, int y, int radius, Color color) {
-    SDL_SetRenderDrawColor(base->sdl_renderer, color.r, color.g, color.b, color.a);
-    // Midpoint circle algorithm (approximation for filled circle)
-    for (int w = -radius; w <= radius; w++) {
-        for (int h = -radius; h <= radius; h++) {
-            if (w * w + h * h <= radius * radius) {
-                SDL_RenderDrawPoint(base->sdl_renderer, x + w, y + h);
-            }
-        }
+void draw_triangle(Base* base, int x1, int y1, int x2, int y2, int x3, int y3, Color color) {
+    // Degenerate (zero-height) triangles draw nothing, as before
+    if (y1 == y2 && y2 == y3) {
+        return;
     }
+    batch_triangle(base->sdl_renderer,
+                   (float)x1, (float)y1, (float)x2, (float)y2, (float)x3, (float)y3,
+                   to_sdl(color));
 }
 
-void draw_triangle(Base* base, int x1, int y1, int x2, int y2, int x3, int y3, Color color) {
-    SDL_SetRenderDrawColor(base->sdl_renderer, color.r, color.g, color.b, color.a);
+/* ---------- corner span cache ---------- */
+// A quarter circle of radius r is stored as r insets: inset[i] is how many
+// pixels row i (counting from the outermost row) gives up at each side.
+// Tables are shared by every shape of the same physical radius, so the
+// same button at the same DPI never recomputes them.
+#define SPAN_CACHE_SIZE 16
 
-    // Sort vertices by y-coordinate (v1 at top, v3 at bottom)
-    int temp_x, temp_y;
-    if (y1 > y2) {
-        temp_x = x1; temp_y = y1;
-        x1 = x2; y1 = y2;
-        x2 = temp_x; y2 = temp_y;
-    }
-    if (y2 > y3) {
-        temp_x = x2; temp_y = y2;
-        x2 = x3; y2 = y3;
-        x3 = temp_x; y3 = temp_y;
-    }
-    if (y1 > y2) {
-        temp_x = x1; temp_y = y1;
-        x1 = x2; y1 = y2;
-        x2 = temp_x; y2 = temp_y;
-    }
+typedef struct {
+    int radius;                // 0 = unused slot
+    int* inset;
+    unsigned last_use;
+} SpanTable;
 
-    // Handle degenerate cases (same y-coordinates)
-    if (y1 == y3) {
-        return;
-    }
+static SpanTable span_cache[SPAN_CACHE_SIZE];
+static unsigned span_clock = 0;
 
-    // Linear interpolation for edges
-    float dx12 = (y2 != y1) ? (float)(x2 - x1) / (y2 - y1) : 0;
-    float dx13 = (y3 != y1) ? (float)(x3 - x1) / (y3 - y1) : 0;
-    float dx23 = (y3 != y2) ? (float)(x3 - x2) / (y3 - y2) : 0;
+static int isqrt(int n) {
+    int r = (int)sqrtf((float)n);
+    while (r * r > n) r--;
+    while ((r + 1) * (r + 1) <= n) r++;
+    return r;
+}
 
-    // Top to middle (y1 to y2)
-    for (int y = y1; y <= y2 && y <= y3; y++) {
-        int x_start = x1 + (int)((y - y1) * dx13);
-        int x_end = (y < y2) ? x1 + (int)((y - y1) * dx12) : x2 + (int)((y - y2) * dx23);
-        if (x_start > x_end) {
-            int temp = x_start;
-            x_start = x_end;
-            x_end = temp;
+static const int* corner_spans(int radius) {
+    SpanTable* victim = &span_cache[0];
+    for (int i = 0; i < SPAN_CACHE_SIZE; i++) {
+        SpanTable* t = &span_cache[i];
+        if (t->radius == radius) {
+            t->last_use = ++span_clock;
+            return t->inset;
+        }
+        if (t->radius == 0 || (victim->radius != 0 && t->last_use < victim->last_use)) {
+            victim = t;
         }
-        SDL_RenderDrawLine(base->sdl_renderer, x_start, y, x_end, y);
     }
 
-    // Middle to bottom (y2 to y3)
-    for (int y = y2 + 1; y <= y3; y++) {
-        int x_start = x1 + (int)((y - y1) * dx13);
-        int x_end = x2 + (int)((y - y2) * dx23);
-        if (x_start > x_end) {
-            int temp = x_start;
-            x_start = x_end;
-            x_end = temp;
-        }
-        SDL_RenderDrawLine(base->sdl_renderer, x_start, y, x_end, y);
+    int* inset = malloc(sizeof(int) * radius);
+    if (!inset) return NULL;
+    int r_sq = radius * radius;
+    for (int i = 0; i < radius; i++) {
+        int d = radius - i;                      // vertical distance to the arc centre
+        inset[i] = radius - isqrt(r_sq - d * d);
     }
+
+    free(victim->inset);
+    victim->radius = radius;
+    victim->inset = inset;
+    victim->last_use = ++span_clock;
+    return inset;
 }
 
-void draw_rounded_rect(Base* base, int x, int y, int w, int h, float roundness, Color color) {
-    SDL_SetRenderDrawColor(base->sdl_renderer, color.r, color.g, color.b, color.a);
+// Scratch rect list reused across calls
+static SDL_Rect* span_rects = NULL;
+static int span_rects_cap = 0;
 
+static SDL_Rect* reserve_span_rects(int n) {
+    if (n > span_rects_cap) {
+        int cap = span_rects_cap ? span_rects_cap : 64;
+        while (cap < n) cap *= 2;
+        SDL_Rect* grown = realloc(span_rects, sizeof(SDL_Rect) * cap);
+        if (!grown) return NULL;
+        span_rects = grown;
+        span_rects_cap = cap;
+    }
+    return span_rects;
+}
+
+void draw_rounded_rect(Base* base, int x, int y, int w, int h, float roundness, Color color) {
     if (w <= 0 || h <= 0) {
         return;
     }
 
-    if (roundness <= 0.0f) {
-        SDL_Rect rect = {x, y, w, h};
-        SDL_RenderFillRect(base->sdl_renderer, &rect);
+    float min_dim = (w < h) ? w : h;
+    int radius = (roundness > 0.0f) ? (int)(roundness * min_dim / 2.0f) : 0;
+
+    // Clamp radius to avoid over-rounding
+    if (2 * radius > w) radius = w / 2;
+    if (2 * radius > h) radius = h / 2;
+
+    const int* inset = radius > 0 ? corner_spans(radius) : NULL;
+    SDL_Rect* rects = inset ? reserve_span_rects(2 * radius + 1) : NULL;
+    if (!rects) {
+        batch_rect(base->sdl_renderer, (float)x, (float)y, (float)w, (float)h, to_sdl(color));
         return;
     }
 
-    float min_dim = (w < h) ? w : h;
-    int radius = (int)(roundness * min_dim / 2.0f);
+    // Corner rows, top and bottom mirrored; rows with the same inset merge
+    int n = 0;
+    for (int i = 0; i < radius; ) {
+        int run = 1;
+        while (i + run < radius && inset[i + run] == inset[i]) run++;
+        int span_w = w - 2 * inset[i];
+        if (span_w > 0) {
+            rects[n++] = (SDL_Rect){ x + inset[i], y + i, span_w, run };
+            rects[n++] = (SDL_Rect){ x + inset[i], y + h - i - run, span_w, run };
+        }
+        i += run;
+    }
+
+    // Body between the corners
+    if (h - 2 * radius > 0) {
+        rects[n++] = (SDL_Rect){ x, y + radius, w, h - 2 * radius };
+    }
+
+    batch_rects(base->sdl_renderer, rects, n, to_sdl(color));
+}
+
+
+
+void draw_circle(Base* base, int x, int y, int radius, Color color) {
     if (radius <= 0) {
-        SDL_Rect rect = {x, y, w, h};
-        SDL_RenderFillRect(base->sdl_renderer, &rect);
+        batch_rect(base->sdl_renderer, (float)x, (float)y, 1.0f, 1.0f, to_sdl(color));
         return;
     }
 
-    // Clamp radius to avoid over-rounding
-    if (2 * radius > w) radius = w / 2;
-    if (2 * radius > h) radius = h / 2;
+    // A circle is four rounded-rect corners with no body in between
+    const int* inset = corner_spans(radius);
+    SDL_Rect* rects = inset ? reserve_span_rects(2 * radius + 1) : NULL;
+    if (!rects) return;
+
+    int n = 0;
+    for (int i = 0; i < radius; ) {
+        int run = 1;
+        while (i + run < radius && inset[i + run] == inset[i]) run++;
+        int half = radius - inset[i];
+        rects[n++] = (SDL_Rect){ x - half, y - radius + i, 2 * half + 1, run };
+        rects[n++] = (SDL_Rect){ x - half, y + radius - i - run + 1, 2 * half + 1, run };
+        i += run;
+    }
+    rects[n++] = (SDL_Rect){ x - radius, y, 2 * radius + 1, 1 };   // equator
+
+    batch_rects(base->sdl_renderer, rects, n, to_sdl(color));
+}
+
+/* ---------- anti-aliased circles ---------- */
+// Small radii come from a white coverage sprite tinted through the draw
+// list's vertex colour, one cached texture per (renderer, radius). Larger
+// ones are a triangle fan with a one-pixel feathered rim.
+#define AA_SPRITE_MAX_RADIUS 32
+#define AA_SPRITE_CACHE_SIZE 16
+
+typedef struct {
+    SDL_Renderer* ren;         // NULL = unused slot
+    SDL_Texture* tex;
+    int radius;
+    unsigned last_use;
+} CircleSprite;
+
+static CircleSprite sprite_cache[AA_SPRITE_CACHE_SIZE];
+static unsigned sprite_clock = 0;
+
+static SDL_Texture* circle_sprite(SDL_Renderer* ren, int radius) {
+    CircleSprite* victim = &sprite_cache[0];
+    for (int i = 0; i < AA_SPRITE_CACHE_SIZE; i++) {
+        CircleSprite* c = &sprite_cache[i];
+        if (c->ren == ren && c->radius == radius) {
+            c->last_use = ++sprite_clock;
+            return c->tex;
+        }
+        if (!c->ren || (victim->ren && c->last_use < victim->last_use)) {
+            victim = c;
+        }
+    }
 
-    int radius_sq = radius * radius;
-
-    for (int dy = 0; dy < h; ++dy) {
-        for (int dx = 0; dx < w; ++dx) {
-            bool inside = false;
-
-            // Inner rectangle
-            if (dx >= radius && dy >= radius && dx < w - radius && dy < h - radius) {
-                inside = true;
-            }
-            // Left strip
-            else if (dx < radius && dy >= radius && dy < h - radius) {
-                inside = true;
-            }
-            // Right strip
-            else if (dx >= w - radius && dy >= radius && dy < h - radius) {
-                inside = true;
-            }
-            // Top strip
-            else if (dy < radius && dx >= radius && dx < w - radius) {
-                inside = true;
-            }
-            // Bottom strip
-            else if (dy >= h - radius && dx >= radius && dx < w - radius) {
-                inside = true;
-            }
-            // Top-left corner
-            else if (dx < radius && dy < radius) {
-                int dx_corner = dx - radius;
-                int dy_corner = dy - radius;
-                if (dx_corner * dx_corner + dy_corner * dy_corner <= radius_sq) {
-                    inside = true;
-                }
-            }
-            // Top-right corner
-            else if (dx >= w - radius && dy < radius) {
-                int dx_corner = dx - (w - radius);
-                int dy_corner = dy - radius;
-                if (dx_corner * dx_corner + dy_corner * dy_corner <= radius_sq) {
-                    inside = true;
-                }
-            }
-            // Bottom-left corner
-            else if (dx < radius && dy >= h - radius) {
-                int dx_corner = dx - radius;
-                int dy_corner = dy - (h - radius);
-                if (dx_corner * dx_corner + dy_corner * dy_corner <= radius_sq) {
-                    inside = true;
-                }
-            }
-            // Bottom-right corner
-            else if (dx >= w - radius && dy >= h - radius) {
-                int dx_corner = dx - (w - radius);
-                int dy_corner = dy - (h - radius);
-                if (dx_corner * dx_corner + dy_corner * dy_corner <= radius_sq) {
-                    inside = true;
-                }
-            }
-
-            if (inside) {
-                SDL_RenderDrawPoint(base->sdl_renderer, x + dx, y + dy);
-            }
+    // Sprite covers the circle plus one pixel of fringe on each side;
+    // the centre sits on the middle of pixel (radius + 1, radius + 1)
+    int size = 2 * radius + 3;
+    Uint32* pixels = malloc(sizeof(Uint32) * size * size);
+    if (!pixels) return NULL;
+    float c = radius + 1.5f;
+    for (int py = 0; py < size; py++) {
+        for (int px = 0; px < size; px++) {
+            float dx = px + 0.5f - c;
+            float dy = py + 0.5f - c;
+            float cover = radius + 0.5f - sqrtf(dx * dx + dy * dy);
+            if (cover < 0.0f) cover = 0.0f;
+            if (cover > 1.0f) cover = 1.0f;
+            Uint32 a = (Uint32)(cover * 255.0f + 0.5f);
+            pixels[py * size + px] = (a << 24) | 0x00FFFFFFu;
         }
     }
+
+    profiler_count(AX_COUNTER_TEXTURE_CREATES, 1);
+    SDL_Texture* tex = SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888,
+                                         SDL_TEXTUREACCESS_STATIC, size, size);
+    if (tex) {
+        SDL_UpdateTexture(tex, NULL, pixels, size * (int)sizeof(Uint32));
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    }
+    free(pixels);
+    if (!tex) return NULL;
+
+    if (victim->tex) {
+        batch_flush();   // queued quads may still sample the old sprite
+        SDL_DestroyTexture(victim->tex);
+    }
+    victim->ren = ren;
+    victim->tex = tex;
+    victim->radius = radius;
+    victim->last_use = ++sprite_clock;
+    return tex;
 }
 
+static SDL_Vertex* fan_verts = NULL;
+static int* fan_indices = NULL;
+static int fan_cap = 0;    // segments the buffers can hold
 
+static void draw_circle_fan(Base* base, int x, int y, int radius, Color color) {
+    int segs = (int)(radius * 1.5f);
+    if (segs < 24) segs = 24;
+    if (segs > 256) segs = 256;
 
-void draw_image(Base * base, const char * file, int x, int y, int w, int h){
-	SDL_Texture * texture = IMG_LoadTexture(base->sdl_renderer, file);
-	if(!texture){
-		printf("Failed to load img %s : %s\n",file, IMG_GetError());
-		return;
-	}
-	 // If width/height are 0, use the texture's actual size
-    if (w <= 0 || h <= 0) {
-        SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+    if (segs > fan_cap) {
+        SDL_Vertex* v = realloc(fan_verts, sizeof(SDL_Vertex) * (2 * segs + 1));
+        if (!v) return;
+        fan_verts = v;
+        int* idx = realloc(fan_indices, sizeof(int) * 9 * segs);
+        if (!idx) return;
+        fan_indices = idx;
+        fan_cap = segs;
     }
 
-    SDL_Rect img_rect = {x, y, w, h}; // x, y, w, h
-    SDL_RenderCopy(base->sdl_renderer, texture, NULL, &img_rect);
-    
-	SDL_DestroyTexture(texture);
+    SDL_Color solid = { color.r, color.g, color.b, color.a };
+    SDL_Color clear = { color.r, color.g, color.b, 0 };
+    float cx = x + 0.5f, cy = y + 0.5f;
+    float inner = radius - 0.5f, outer = radius + 0.5f;
+
+    // vertex 0 = centre, 1 + 2k = inner rim, 2 + 2k = outer (transparent) rim
+    fan_verts[0] = (SDL_Vertex){ { cx, cy }, solid, { 0, 0 } };
+    for (int k = 0; k < segs; k++) {
+        float a = (float)k / segs * 6.2831853f;
+        float ca = cosf(a), sa = sinf(a);
+        fan_verts[1 + 2 * k] = (SDL_Vertex){ { cx + ca * inner, cy + sa * inner }, solid, { 0, 0 } };
+        fan_verts[2 + 2 * k] = (SDL_Vertex){ { cx + ca * outer, cy + sa * outer }, clear, { 0, 0 } };
+    }
+
+    int n = 0;
+    for (int k = 0; k < segs; k++) {
+        int i0 = 1 + 2 * k, o0 = 2 + 2 * k;
+        int i1 = 1 + 2 * ((k + 1) % segs), o1 = 2 + 2 * ((k + 1) % segs);
+        fan_indices[n++] = 0;  fan_indices[n++] = i0; fan_indices[n++] = i1;
+        fan_indices[n++] = i0; fan_indices[n++] = o0; fan_indices[n++] = o1;
+        fan_indices[n++] = i0; fan_indices[n++] = o1; fan_indices[n++] = i1;
+    }
+
+    batch_geometry(base->sdl_renderer, NULL, fan_verts, 2 * segs + 1, fan_indices, n);
+}
+
+void draw_circle_aa(Base* base, int x, int y, int radius, Color color) {
+    if (radius <= 0) return;
+
+    SDL_Renderer* ren = base->sdl_renderer;
+
+    if (radius <= AA_SPRITE_MAX_RADIUS) {
+        SDL_Texture* tex = circle_sprite(ren, radius);
+        if (tex) {
+            // Tinted through the vertex colour, so sprites of one radius
+            // batch together whatever their colour
+            int size = 2 * radius + 3;
+            SDL_Rect dst = { x - radius - 1, y - radius - 1, size, size };
+            batch_texture(ren, tex, NULL, &dst, to_sdl(color));
+            return;
+        }
+    }
+    draw_circle_fan(base, x, y, radius, color);
+}
+
+void draw_release_renderer(SDL_Renderer* ren) {
+    batch_flush();
+    for (int i = 0; i < AA_SPRITE_CACHE_SIZE; i++) {
+        CircleSprite* c = &sprite_cache[i];
+        if (c->ren == ren) {
+            SDL_DestroyTexture(c->tex);
+            *c = (CircleSprite){0};
+        }
+    }
+}
+
+void draw_image(Base * base, const char * file, int x, int y, int w, int h){
+	// Shared with image widgets; after the first call this is a cache hit
+	ImageHandle * image = image_backend_load(base->sdl_renderer, file);
+	if(!image) return;
+	image_backend_draw(base->sdl_renderer, image, x, y, w, h);
+	image_backend_free(image);   // last released is kept, even past the budget
 }
 
 void draw_image_from_texture(Base *base, void * texture_ptr, int x, int y, int w, int h){
@@ -210,5 +337,5 @@ void draw_image_from_texture(Base *base, void * texture_ptr, int x, int y, int w
     }
 
     SDL_Rect img_rect = {x, y, w, h}; // x, y, w, h
-    SDL_RenderCopy(base->sdl_renderer, texture, NULL, &img_rect);
+    batch_texture(base->sdl_renderer, texture, NULL, &img_rect, (SDL_Color){255, 255, 255, 255});
 }
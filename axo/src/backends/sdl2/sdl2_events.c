@@ -1,4 +1,5 @@
 #include "../../../include/backends/sdl2/sdl2_events.h"
+#include "../../../include/core/profiler.h"
 #include <SDL2/SDL.h>
 #include <string.h>
 
@@ -148,6 +149,10 @@ int translate_sdl_event(const SDL_Event *s, axEvent *out) {
                 out->type = EVENT_WINDOWCLOSE;
                 return 1;
             }
+            if (s->window.event == SDL_WINDOWEVENT_EXPOSED) {
+                out->type = EVENT_WINDOWEXPOSED;
+                return 1;
+            }
             break;
 
         case SDL_QUIT:
@@ -161,15 +166,158 @@ int translate_sdl_event(const SDL_Event *s, axEvent *out) {
 }
 
 /* --------------------------------------------------------------------- */
-/* ORIGINAL POLLING (unchanged)                                          */
+/* SCRIPTED INPUT (headless runs, tests)                                 */
 /* --------------------------------------------------------------------- */
-int poll_event(axEvent *out) {
-    SDL_Event s;
-    while (SDL_PollEvent(&s)) {
-        if (translate_sdl_event(&s, out)) {
+#define INJECT_QUEUE_SIZE 256
+
+static struct {
+    axEvent events[INJECT_QUEUE_SIZE];
+    int head, count;
+} inject_queue = {0};
+
+// Pointer state as of the last event handed out. Widgets read the
+// position from here instead of asking SDL for every event they see.
+static struct {
+    bool enabled;      // virtual mode: never fall back to SDL
+    bool known;        // a pointer event has been seen
+    int x, y;
+    Uint32 buttons;
+} virtual_mouse = {0};
+
+int input_push_event(const axEvent *ev)
+{
+    if (!ev || inject_queue.count == INJECT_QUEUE_SIZE) return 0;
+    int tail = (inject_queue.head + inject_queue.count) % INJECT_QUEUE_SIZE;
+    inject_queue.events[tail] = *ev;
+    inject_queue.count++;
+    return 1;
+}
+
+void input_set_virtual_mouse(bool enabled)
+{
+    virtual_mouse.enabled = enabled;
+}
+
+// Keeps the cached pointer where the events say it is
+static void track_virtual_mouse(const axEvent *ev)
+{
+    switch (ev->type) {
+        case EVENT_MOUSEMOTION:
+            virtual_mouse.x = ev->mouseMove.x;
+            virtual_mouse.y = ev->mouseMove.y;
+            break;
+        case EVENT_MOUSEBUTTONDOWN:
+            virtual_mouse.x = ev->mouseButton.x;
+            virtual_mouse.y = ev->mouseButton.y;
+            virtual_mouse.buttons |= SDL_BUTTON((int)ev->mouseButton.button);
+            break;
+        case EVENT_MOUSEBUTTONUP:
+            virtual_mouse.x = ev->mouseButton.x;
+            virtual_mouse.y = ev->mouseButton.y;
+            virtual_mouse.buttons &= ~SDL_BUTTON((int)ev->mouseButton.button);
+            break;
+        default:
+            return;
+    }
+    virtual_mouse.known = true;
+}
+
+static int pop_injected(axEvent *out)
+{
+    if (inject_queue.count == 0) return 0;
+    *out = inject_queue.events[inject_queue.head];
+    inject_queue.head = (inject_queue.head + 1) % INJECT_QUEUE_SIZE;
+    inject_queue.count--;
+    return 1;
+}
+
+/* --------------------------------------------------------------------- */
+/* BATCHED PUMPING                                                       */
+/* --------------------------------------------------------------------- */
+static struct {
+    axEvent events[EVENT_BATCH_SIZE];
+    int head, count;
+} batch = {0};
+
+// Appends to the batch, folding motion into a motion event still waiting
+// at its tail. 0 if the batch is full.
+static int batch_push(const axEvent *ev)
+{
+    if (ev->type == EVENT_MOUSEMOTION && batch.count > 0) {
+        axEvent *last = &batch.events[(batch.head + batch.count - 1) % EVENT_BATCH_SIZE];
+        if (last->type == EVENT_MOUSEMOTION) {
+            last->mouseMove.x = ev->mouseMove.x;
+            last->mouseMove.y = ev->mouseMove.y;
+            last->mouseMove.dx += ev->mouseMove.dx;
+            last->mouseMove.dy += ev->mouseMove.dy;
+            last->mouseMove.button_state = ev->mouseMove.button_state;
+            profiler_count(AX_COUNTER_MOTION_MERGED, 1);
             return 1;
         }
     }
+    if (batch.count == EVENT_BATCH_SIZE) return 0;
+    batch.events[(batch.head + batch.count) % EVENT_BATCH_SIZE] = *ev;
+    batch.count++;
+    return 1;
+}
+
+int pump_events(void)
+{
+    // Injected events go first, as they do for poll_event
+    while (inject_queue.count > 0 && batch_push(&inject_queue.events[inject_queue.head])) {
+        inject_queue.head = (inject_queue.head + 1) % INJECT_QUEUE_SIZE;
+        inject_queue.count--;
+    }
+    if (inject_queue.count > 0) return batch.count;
+
+    // Take no more than there is room for, so nothing is dropped; merging
+    // only frees room. What is left stays with SDL until the next pump.
+    static SDL_Event pending[EVENT_BATCH_SIZE];
+    SDL_PumpEvents();
+    int room;
+    while ((room = EVENT_BATCH_SIZE - batch.count) > 0) {
+        int n = SDL_PeepEvents(pending, room, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+        if (n <= 0) break;
+        axEvent ev;
+        for (int i = 0; i < n; i++) {
+            if (translate_sdl_event(&pending[i], &ev)) batch_push(&ev);
+        }
+    }
+    return batch.count;
+}
+
+int next_event(axEvent *out)
+{
+    if (batch.count == 0) return 0;
+    *out = batch.events[batch.head];
+    batch.head = (batch.head + 1) % EVENT_BATCH_SIZE;
+    batch.count--;
+    // The cached pointer follows the events as they are handed out, not
+    // as they are pumped
+    track_virtual_mouse(out);
+    return 1;
+}
+
+/* --------------------------------------------------------------------- */
+/* ORIGINAL POLLING                                                      */
+/* --------------------------------------------------------------------- */
+int poll_event(axEvent *out) {
+    if (batch.count == 0) pump_events();
+    return next_event(out);
+}
+
+int wait_event(axEvent *out, int timeout_ms) {
+    if (next_event(out)) return 1;
+    if (pop_injected(out)) {
+        track_virtual_mouse(out);
+        return 1;
+    }
+
+    SDL_Event s;
+    if (SDL_WaitEventTimeout(&s, timeout_ms) && translate_sdl_event(&s, out)) {
+        track_virtual_mouse(out);
+        return 1;
+    }
     return 0;
 }
 
@@ -182,12 +330,18 @@ void disable_text_input(void) { SDL_StopTextInput(); }
 
 void input_get_mouse(int *x, int *y)
 {
+    if (virtual_mouse.enabled || virtual_mouse.known) {
+        if (x) *x = virtual_mouse.x;
+        if (y) *y = virtual_mouse.y;
+        return;
+    }
     SDL_GetMouseState(x, y);
 }
 
 bool input_mouse_down(MouseButton btn)
 {
-    Uint32 state = SDL_GetMouseState(NULL, NULL);
+    Uint32 state = virtual_mouse.enabled ? virtual_mouse.buttons
+                                         : SDL_GetMouseState(NULL, NULL);
     return (state & SDL_BUTTON((int)btn)) != 0;
 }
 
@@ -1,37 +1,571 @@
 /* image_backend_sdl.c – the *only* file that knows about SDL_image */
 #include "../../../include/backends/sdl2/sdl2_image.h"
+#include "../../../include/backends/sdl2/sdl2_batch.h"
+#include "../../../include/core/profiler.h"
 #include <SDL2/SDL_image.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
+/* ------------------------------------------------------------------ */
+/*  Texture cache (refcounted, LRU of unreferenced, byte budget)       */
+/* ------------------------------------------------------------------ */
+#define IMAGE_CACHE_BUCKETS 256   /* power of two */
+
+/* A path as the caller spelled it, so a repeat load skips realpath.
+ * Relative spellings assume the working directory stays put. */
+typedef struct ImageAlias {
+    struct ImageAlias* bucket_next;
+    struct ImageAlias* owner_next;    /* the handle's other spellings */
+    ImageHandle*       handle;
+    Uint64             hash;
+    char               path[];
+} ImageAlias;
+
+static struct {
+    ImageHandle*    buckets[IMAGE_CACHE_BUCKETS];
+    ImageAlias*     aliases[IMAGE_CACHE_BUCKETS];
+    ImageHandle*    lru_head;     /* most recently released  */
+    ImageHandle*    lru_tail;     /* least recently released */
+    ImageCacheStats stats;
+} image_cache = { .stats = { .budget = 32u * 1024u * 1024u } };
+
+static Uint64 fnv1a64(const void* data, size_t n)
+{
+    const unsigned char* p = data;
+    Uint64 h = 14695981039346656037ull;
+    for (size_t i = 0; i < n; i++) { h ^= p[i]; h *= 1099511628211ull; }
+    return h;
+}
+
+/* Same file, same key, however the path was spelled */
+static char* canonical_path(const char* path)
+{
+#ifdef _WIN32
+    char* full = _fullpath(NULL, path, 0);
+#else
+    char* full = realpath(path, NULL);
+#endif
+    return full ? full : strdup(path);   /* missing file: IMG reports it */
+}
+
+static void lru_unlink(ImageHandle* h)
+{
+    if (h->lru_prev) h->lru_prev->lru_next = h->lru_next; else image_cache.lru_head = h->lru_next;
+    if (h->lru_next) h->lru_next->lru_prev = h->lru_prev; else image_cache.lru_tail = h->lru_prev;
+    h->lru_prev = h->lru_next = NULL;
+}
+
+static void lru_push_front(ImageHandle* h)
+{
+    h->lru_prev = NULL;
+    h->lru_next = image_cache.lru_head;
+    if (image_cache.lru_head) image_cache.lru_head->lru_prev = h;
+    image_cache.lru_head = h;
+    if (!image_cache.lru_tail) image_cache.lru_tail = h;
+}
+
+static void alias_add(ImageHandle* h, Uint64 hash, const char* path)
+{
+    size_t n = strlen(path) + 1;
+    ImageAlias* a = malloc(sizeof *a + n);
+    if (!a) return;   /* only the shortcut is lost */
+    memcpy(a->path, path, n);
+    a->hash   = hash;
+    a->handle = h;
+    ImageAlias** bucket = &image_cache.aliases[hash & (IMAGE_CACHE_BUCKETS - 1)];
+    a->bucket_next = *bucket;
+    *bucket = a;
+    a->owner_next = h->aliases;
+    h->aliases = a;
+}
+
+static ImageHandle* alias_find(SDL_Renderer* ren, Uint64 hash, const char* path)
+{
+    for (ImageAlias* a = image_cache.aliases[hash & (IMAGE_CACHE_BUCKETS - 1)]; a; a = a->bucket_next) {
+        ImageHandle* h = a->handle;
+        if (a->hash == hash && h->ren == ren && h->state != IMAGE_FAILED && strcmp(a->path, path) == 0) return h;
+    }
+    return NULL;
+}
+
+static void alias_drop_all(ImageHandle* h)
+{
+    while (h->aliases) {
+        ImageAlias* a = h->aliases;
+        ImageAlias** it = &image_cache.aliases[a->hash & (IMAGE_CACHE_BUCKETS - 1)];
+        while (*it && *it != a) it = &(*it)->bucket_next;
+        if (*it) *it = a->bucket_next;
+        h->aliases = a->owner_next;
+        free(a);
+    }
+}
+
+/* Only unreferenced handles get here */
+static void image_cache_remove(ImageHandle* h)
+{
+    ImageHandle** it = &image_cache.buckets[h->hash & (IMAGE_CACHE_BUCKETS - 1)];
+    while (*it && *it != h) it = &(*it)->bucket_next;
+    if (*it) *it = h->bucket_next;
+    alias_drop_all(h);
+
+    lru_unlink(h);
+    image_cache.stats.bytes -= h->bytes;
+    image_cache.stats.entries--;
+    if (h->texture) {
+        batch_flush();   /* queued draws may still sample it */
+        SDL_DestroyTexture(h->texture);
+    }
+    free(h->path);
+    free(h);
+}
+
+static void image_cache_trim(size_t budget)
+{
+    while (image_cache.stats.bytes > budget && image_cache.lru_tail) {
+        image_cache_remove(image_cache.lru_tail);
+        image_cache.stats.evictions++;
+    }
+}
+
+static ImageHandle* image_cache_find(SDL_Renderer* ren, Uint64 hash, const char* path, size_t size)
+{
+    for (ImageHandle* h = image_cache.buckets[hash & (IMAGE_CACHE_BUCKETS - 1)]; h; h = h->bucket_next) {
+        if (h->hash != hash || h->ren != ren || h->state == IMAGE_FAILED) continue;
+        if (path ? (h->path && strcmp(h->path, path) == 0) : (!h->path && h->size == size)) return h;
+    }
+    return NULL;
+}
+
+/* Gives a referenced handle its texture */
+static void image_cache_fill(ImageHandle* h, SDL_Texture* tex)
+{
+    SDL_QueryTexture(tex, NULL, NULL, &h->w, &h->h);
+    h->texture = tex;
+    h->state   = IMAGE_READY;
+    h->bytes   = (size_t)h->w * (size_t)h->h * 4;
+
+    /* make room among the unreferenced ones first */
+    image_cache_trim(h->bytes < image_cache.stats.budget ? image_cache.stats.budget - h->bytes : 0);
+    image_cache.stats.bytes += h->bytes;
+}
+
+/* Takes ownership of `path`; a NULL `tex` makes a loading handle */
+static ImageHandle* image_cache_insert(SDL_Renderer* ren, SDL_Texture* tex, Uint64 hash,
+                                       char* path, size_t size)
+{
+    ImageHandle* h = calloc(1, sizeof *h);
+    if (!h) {
+        if (tex) SDL_DestroyTexture(tex);
+        free(path);
+        return NULL;
+    }
+    h->ren  = ren;   h->path = path;  h->state = IMAGE_LOADING;
+    h->hash = hash;  h->size = size;  h->refs  = 1;
+
+    ImageHandle** bucket = &image_cache.buckets[hash & (IMAGE_CACHE_BUCKETS - 1)];
+    h->bucket_next = *bucket;
+    *bucket = h;
+    image_cache.stats.entries++;
+    image_cache.stats.referenced++;
+    if (tex) image_cache_fill(h, tex);
+    return h;
+}
+
+ImageHandle *image_backend_retain(ImageHandle *h)
+{
+    if (!h) return NULL;
+    if (h->refs++ == 0) {
+        lru_unlink(h);
+        image_cache.stats.referenced++;
+    }
+    return h;
+}
+
+/* A referenced hit for `path`, however it is spelled. Only a miss on the
+ * raw spelling canonicalizes; a miss on both leaves the canonical path
+ * (the caller's to free) in *key and its hash in *hash. */
+static ImageHandle* image_cache_find_path(SDL_Renderer* ren, const char* path, Uint64 raw_hash,
+                                          char** key, Uint64* hash)
+{
+    *key = NULL;
+    ImageHandle* h = alias_find(ren, raw_hash, path);
+    if (!h) {
+        *key = canonical_path(path);
+        if (!*key) return NULL;
+        *hash = fnv1a64(*key, strlen(*key));
+        h = image_cache_find(ren, *hash, *key, 0);
+        if (!h) return NULL;
+        free(*key);
+        *key = NULL;
+        alias_add(h, raw_hash, path);
+    }
+    image_cache.stats.hits++;
+    return image_backend_retain(h);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Backend entry points                                               */
+/* ------------------------------------------------------------------ */
 ImageHandle *image_backend_load(SDL_Renderer *ren, const char *path)
 {
+    if (!ren || !path) return NULL;
+    Uint64 raw_hash = fnv1a64(path, strlen(path));
+    Uint64 hash = 0;
+    char* key;
+    ImageHandle* hit = image_cache_find_path(ren, path, raw_hash, &key, &hash);
+    if (hit || !key) return hit;
+
+    image_cache.stats.misses++;
     SDL_Texture *tex = IMG_LoadTexture(ren, path);
+    profiler_count(AX_COUNTER_TEXTURE_CREATES, 1);
     if (!tex) {
         printf("IMG_LoadTexture(%s) failed: %s\n", path, IMG_GetError());
+        free(key);
         return NULL;
     }
-
-    ImageHandle *h = malloc(sizeof *h);
-    if (h) h->texture = tex;
+    ImageHandle* h = image_cache_insert(ren, tex, hash, key, 0);
+    if (h) alias_add(h, raw_hash, path);
     return h;
 }
 
+ImageHandle *image_backend_load_mem(SDL_Renderer *ren, const void *data, size_t size)
+{
+    if (!ren || !data || size == 0) return NULL;
+    Uint64 hash = fnv1a64(data, size);
+
+    ImageHandle* hit = image_cache_find(ren, hash, NULL, size);
+    if (hit) {
+        image_cache.stats.hits++;
+        return image_backend_retain(hit);
+    }
+
+    image_cache.stats.misses++;
+    SDL_RWops* rw = SDL_RWFromConstMem(data, (int)size);
+    SDL_Texture *tex = rw ? IMG_LoadTexture_RW(ren, rw, 1) : NULL;
+    profiler_count(AX_COUNTER_TEXTURE_CREATES, 1);
+    if (!tex) {
+        printf("IMG_LoadTexture_RW(<memory>) failed: %s\n", IMG_GetError());
+        return NULL;
+    }
+    return image_cache_insert(ren, tex, hash, NULL, size);
+}
+
 void image_backend_draw(SDL_Renderer *ren, ImageHandle *h,
                         int sx, int sy, int sw, int sh)
 {
+    if (!h || !h->texture) return;
 	 // If width/height are 0, use the texture's actual size
     if (sw <= 0 || sh <= 0) {
-        SDL_QueryTexture(h->texture, NULL, NULL, &sw, &sh);
+        sw = h->w;
+        sh = h->h;
     }
 
     SDL_Rect dst = { sx, sy, sw, sh };
-    SDL_RenderCopy(ren, h->texture, NULL, &dst);
+    batch_texture(ren, h->texture, NULL, &dst, (SDL_Color){255, 255, 255, 255});
 }
 
+/* Gives back a reference; the texture stays cached until the budget
+ * needs the room. The one just released is never the one evicted, so
+ * an image larger than the whole budget still survives to the next
+ * frame; the next release or budget change drops it. */
 void image_backend_free(ImageHandle *h)
 {
-    if (h) {
-        if (h->texture) SDL_DestroyTexture(h->texture);
-        free(h);
+    if (!h || h->refs <= 0) return;
+    if (--h->refs > 0) return;
+    image_cache.stats.referenced--;
+    if (!h->texture) {
+        lru_push_front(h);
+        image_cache_remove(h);   // its renderer is gone, nothing to reuse
+        return;
+    }
+    image_cache_trim(image_cache.stats.budget);   /* h is not in the LRU yet */
+    lru_push_front(h);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Cache control                                                      */
+/* ------------------------------------------------------------------ */
+void image_cache_stats(ImageCacheStats *out)
+{
+    if (out) *out = image_cache.stats;
+}
+
+void image_cache_set_budget(size_t bytes)
+{
+    image_cache.stats.budget = bytes;
+    image_cache_trim(bytes);
+}
+
+void image_cache_clear(void)
+{
+    while (image_cache.lru_head) image_cache_remove(image_cache.lru_head);
+}
+
+void image_release_renderer(SDL_Renderer *ren)
+{
+    batch_flush();
+    for (int b = 0; b < IMAGE_CACHE_BUCKETS; b++) {
+        ImageHandle* h = image_cache.buckets[b];
+        while (h) {
+            ImageHandle* next = h->bucket_next;
+            if (h->ren == ren) {
+                if (h->refs == 0) {
+                    image_cache_remove(h);
+                } else {
+                    // Still held by a widget: keep the handle, lose the pixels
+                    if (h->texture) SDL_DestroyTexture(h->texture);
+                    h->texture = NULL;
+                    h->ren = NULL;
+                    image_cache.stats.bytes -= h->bytes;
+                    h->bytes = 0;
+                }
+            }
+            h = next;
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/*  Async decoding                                                     */
+/* ------------------------------------------------------------------ */
+/* Workers only decode: IMG_Load to a surface. Textures belong to the
+ * renderer's thread, so the upload and every cache update happen in
+ * image_backend_upload. */
+typedef struct ImageJob {
+    struct ImageJob* next;
+    ImageHandle*     handle;      /* the job holds a reference */
+    char*            path;        /* file to decode, or NULL ...        */
+    void*            data;        /* ... a copy of the bytes to decode */
+    size_t           size;
+    SDL_Surface*     surface;     /* result, NULL if decoding failed */
+    char             error[128];  /* IMG errors are per thread */
+} ImageJob;
+
+static struct {
+    SDL_Thread* threads[IMAGE_WORKERS_MAX];
+    int         thread_count;
+    SDL_mutex*  lock;             /* guards the two queues and quit */
+    SDL_cond*   wake;
+    ImageJob*   todo_head;
+    ImageJob*   todo_tail;
+    ImageJob*   done_head;
+    ImageJob*   done_tail;
+    bool        quit;
+    int         outstanding;      /* submitted, not yet uploaded (main thread) */
+    Uint32      wake_event;       /* ends axRun's idle wait when a decode lands */
+} pool;
+
+static void job_append(ImageJob** head, ImageJob** tail, ImageJob* job)
+{
+    job->next = NULL;
+    if (*tail) (*tail)->next = job; else *head = job;
+    *tail = job;
+}
+
+static ImageJob* job_pop(ImageJob** head, ImageJob** tail)
+{
+    ImageJob* job = *head;
+    if (job) {
+        *head = job->next;
+        if (!*head) *tail = NULL;
+    }
+    return job;
+}
+
+static void wake_main_thread(void)
+{
+    if (pool.wake_event == (Uint32)-1) return;
+    SDL_Event e;
+    SDL_zero(e);
+    e.type = pool.wake_event;
+    SDL_PushEvent(&e);
+}
+
+static int image_worker(void* unused)
+{
+    (void)unused;
+    SDL_LockMutex(pool.lock);
+    for (;;) {
+        while (!pool.todo_head && !pool.quit) SDL_CondWait(pool.wake, pool.lock);
+        if (pool.quit) break;
+        ImageJob* job = job_pop(&pool.todo_head, &pool.todo_tail);
+        SDL_UnlockMutex(pool.lock);
+
+        job->surface = job->path ? IMG_Load(job->path)
+                                 : IMG_Load_RW(SDL_RWFromConstMem(job->data, (int)job->size), 1);
+        if (!job->surface) SDL_strlcpy(job->error, IMG_GetError(), sizeof job->error);
+
+        SDL_LockMutex(pool.lock);
+        job_append(&pool.done_head, &pool.done_tail, job);
+        SDL_UnlockMutex(pool.lock);
+        wake_main_thread();
+        SDL_LockMutex(pool.lock);
+    }
+    SDL_UnlockMutex(pool.lock);
+    return 0;
+}
+
+static bool pool_start(void)
+{
+    if (pool.thread_count > 0) return true;
+    pool.lock = SDL_CreateMutex();
+    pool.wake = SDL_CreateCond();
+    if (pool.lock && pool.wake) {
+        pool.wake_event = SDL_RegisterEvents(1);
+        int n = SDL_GetCPUCount() - 1;   /* leave a core to the UI */
+        if (n < 1) n = 1;
+        if (n > IMAGE_WORKERS_MAX) n = IMAGE_WORKERS_MAX;
+        for (int i = 0; i < n; i++) {
+            SDL_Thread* t = SDL_CreateThread(image_worker, "axo-image", NULL);
+            if (!t) break;
+            pool.threads[pool.thread_count++] = t;
+        }
+    }
+    if (pool.thread_count > 0) return true;
+
+    printf("Failed to start image decoder threads: %s\n", SDL_GetError());
+    if (pool.wake) SDL_DestroyCond(pool.wake);
+    if (pool.lock) SDL_DestroyMutex(pool.lock);
+    memset(&pool, 0, sizeof pool);
+    return false;
+}
+
+/* Hands a loading handle to the workers; NULL if the job can't be made */
+static ImageHandle* image_submit(ImageHandle* h, const char* path, const void* data, size_t size)
+{
+    ImageJob* job = calloc(1, sizeof *job);
+    if (job) {
+        job->path = path ? strdup(path) : NULL;
+        job->data = data ? malloc(size) : NULL;
+        job->size = size;
+    }
+    if (!job || (path && !job->path) || (data && !job->data)) {
+        printf("Failed to queue image load\n");
+        if (job) { free(job->path); free(job->data); free(job); }
+        h->state = IMAGE_FAILED;
+        image_backend_free(h);
+        return NULL;
+    }
+    if (data) memcpy(job->data, data, size);
+    job->handle = image_backend_retain(h);
+    pool.outstanding++;
+
+    SDL_LockMutex(pool.lock);
+    job_append(&pool.todo_head, &pool.todo_tail, job);
+    SDL_CondSignal(pool.wake);
+    SDL_UnlockMutex(pool.lock);
+    return h;
+}
+
+/* Main thread: the load is over, one way or the other */
+static void job_finish(ImageJob* job)
+{
+    ImageHandle* h = job->handle;
+    if (h->state == IMAGE_LOADING) h->state = IMAGE_FAILED;
+    if (job->surface) SDL_FreeSurface(job->surface);
+    free(job->path);
+    free(job->data);
+    free(job);
+    pool.outstanding--;
+    image_backend_free(h);   /* the job's reference */
+}
+
+static void job_upload(ImageJob* job)
+{
+    ImageHandle* h = job->handle;
+    if (!h->ren) {            /* its renderer went away meanwhile */
+        job_finish(job);
+        return;
+    }
+    SDL_Texture* tex = NULL;
+    if (job->surface) {
+        tex = SDL_CreateTextureFromSurface(h->ren, job->surface);
+        profiler_count(AX_COUNTER_TEXTURE_CREATES, 1);
+        if (!tex) SDL_strlcpy(job->error, SDL_GetError(), sizeof job->error);
+    }
+    if (tex) {
+        image_cache_fill(h, tex);
+    } else {
+        printf("IMG_Load(%s) failed: %s\n", job->path ? job->path : "<memory>", job->error);
+    }
+    job_finish(job);
+}
+
+ImageHandle *image_backend_load_async(SDL_Renderer *ren, const char *path)
+{
+    if (!ren || !path) return NULL;
+    Uint64 raw_hash = fnv1a64(path, strlen(path));
+    Uint64 hash = 0;
+    char* key;
+    ImageHandle* hit = image_cache_find_path(ren, path, raw_hash, &key, &hash);
+    if (hit || !key) return hit;
+    if (!pool_start()) {
+        free(key);
+        return image_backend_load(ren, path);
+    }
+
+    image_cache.stats.misses++;
+    ImageHandle* h = image_cache_insert(ren, NULL, hash, key, 0);
+    if (!h) return NULL;
+    alias_add(h, raw_hash, path);
+    return image_submit(h, h->path, NULL, 0);
+}
+
+ImageHandle *image_backend_load_mem_async(SDL_Renderer *ren, const void *data, size_t size)
+{
+    if (!ren || !data || size == 0) return NULL;
+    Uint64 hash = fnv1a64(data, size);
+
+    ImageHandle* hit = image_cache_find(ren, hash, NULL, size);
+    if (hit) {
+        image_cache.stats.hits++;
+        return image_backend_retain(hit);
+    }
+    if (!pool_start()) return image_backend_load_mem(ren, data, size);
+
+    image_cache.stats.misses++;
+    ImageHandle* h = image_cache_insert(ren, NULL, hash, NULL, size);
+    return h ? image_submit(h, NULL, data, size) : NULL;
+}
+
+int image_backend_upload(Uint32 budget_ms)
+{
+    if (pool.outstanding == 0) return 0;
+    Uint64 start  = SDL_GetPerformanceCounter();
+    Uint64 budget = SDL_GetPerformanceFrequency() * budget_ms / 1000;
+    int finished = 0;
+    for (;;) {
+        SDL_LockMutex(pool.lock);
+        ImageJob* job = job_pop(&pool.done_head, &pool.done_tail);
+        bool more = pool.done_head != NULL;
+        SDL_UnlockMutex(pool.lock);
+        if (!job) break;
+
+        job_upload(job);
+        finished++;
+        if (more && SDL_GetPerformanceCounter() - start >= budget) {
+            wake_main_thread();   /* the rest go next frame */
+            break;
+        }
     }
+    return finished;
+}
+
+void image_async_shutdown(void)
+{
+    if (pool.thread_count == 0) return;
+    SDL_LockMutex(pool.lock);
+    pool.quit = true;
+    SDL_CondBroadcast(pool.wake);
+    SDL_UnlockMutex(pool.lock);
+    for (int i = 0; i < pool.thread_count; i++) SDL_WaitThread(pool.threads[i], NULL);
+
+    ImageJob* job;
+    while ((job = job_pop(&pool.todo_head, &pool.todo_tail))) job_finish(job);
+    while ((job = job_pop(&pool.done_head, &pool.done_tail))) job_finish(job);
+    SDL_DestroyCond(pool.wake);
+    SDL_DestroyMutex(pool.lock);
+    memset(&pool, 0, sizeof pool);
 }
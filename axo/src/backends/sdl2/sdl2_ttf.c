@@ -1,32 +1,698 @@
 /* sdl2_ttf.c – only this file includes the real SDL_ttf.h */
 #include "../../../include/backends/sdl2/sdl2_ttf.h"
 #include "../../../include/core/theme.h"
+#include "../../../include/core/profiler.h"
 #include <SDL2/SDL_ttf.h>
 #include <stdlib.h>
 #include <string.h>
 
+/* ------------------------------------------------------------------ */
+/*  Glyph atlas                                                        */
+/*                                                                     */
+/*  Every font keeps its rasterized glyphs (rendered white, tinted by  */
+/*  vertex colour at draw time) packed into a few texture pages, so a  */
+/*  string is drawn as textured quads with SDL_RenderGeometry instead  */
+/*  of being rasterized and uploaded again on every frame.             */
+/* ------------------------------------------------------------------ */
+#define ATLAS_PAGE_SIZE   512
+#define ATLAS_MAX_PAGES   8
+#define ATLAS_GLYPH_PAD   1
+
+typedef struct {
+    Uint32 codepoint;     /* 0 = empty slot                          */
+    Sint16 page;          /* -1 = nothing to draw (e.g. whitespace)  */
+    Sint16 x, y, w, h;    /* location of the bitmap inside the page  */
+    Sint16 x_off;         /* bitmap offset from the pen position     */
+    Sint16 advance;       /* horizontal advance in pixels            */
+} Glyph;
+
+typedef struct {
+    SDL_Renderer* renderer;                 /* owner of the page textures  */
+    SDL_Texture*  pages[ATLAS_MAX_PAGES];
+    int           page_count;
+    int           shelf_x, shelf_y, shelf_h; /* packer cursor (last page)  */
+    Glyph*        glyphs;                   /* open-addressing hash table */
+    int           glyph_cap;                /* power of two               */
+    int           glyph_count;
+} GlyphAtlas;
+
+/* ------------------------------------------------------------------ */
+/*  Advance table                                                      */
+/*                                                                     */
+/*  Measuring reads cached glyph advances instead of going through     */
+/*  TTF_SizeUTF8: ASCII sits in a flat array, other codepoints in a    */
+/*  small hash, and kerning between ASCII pairs in a 128x128 table.    */
+/*  Everything is filled lazily on first lookup.                       */
+/* ------------------------------------------------------------------ */
+#define ADVANCE_UNKNOWN  (-32768)   /* Sint16 sentinel                */
+#define KERN_UNKNOWN     (-128)     /* Sint8 sentinel                 */
+
+typedef struct {
+    Uint32 codepoint;     /* 0 = empty slot */
+    Sint16 advance;
+} AdvanceSlot;
+
+typedef struct {
+    Sint16       ascii[128];
+    Sint8*       ascii_kern;         /* [prev * 128 + cp], only for kerning fonts */
+    AdvanceSlot* slots;              /* open-addressing hash, power-of-two cap */
+    int          cap;
+    int          count;
+} AdvanceTable;
+
 struct Font_ttf {
-    TTF_Font* font;
+    TTF_Font*  font;
+    int        kerning;       /* TTF_GetFontKerning at load time */
+    GlyphAtlas atlas;
+    AdvanceTable advances;
+    Font_ttf*  next_live;     /* list of live fonts (see ttf_release_renderer) */
 };
 
+static Font_ttf* live_fonts = NULL;
+
+static void text_cache_purge(const Font_ttf* font, const SDL_Renderer* ren);
+
+static Font_ttf* wrap_font(TTF_Font* raw)
+{
+    Font_ttf* f = calloc(1, sizeof *f);
+    if (!f) { TTF_CloseFont(raw); return NULL; }
+    f->font    = raw;
+    f->kerning = TTF_GetFontKerning(raw);
+    for (int i = 0; i < 128; ++i) f->advances.ascii[i] = ADVANCE_UNKNOWN;
+    f->next_live = live_fonts;
+    live_fonts = f;
+    return f;
+}
+
+static void atlas_drop_pages(GlyphAtlas* a)
+{
+    for (int i = 0; i < a->page_count; ++i) {
+        if (a->pages[i]) {
+            batch_flush();
+            SDL_DestroyTexture(a->pages[i]);
+        }
+        a->pages[i] = NULL;
+    }
+    a->page_count = 0;
+    a->shelf_x = a->shelf_y = a->shelf_h = 0;
+    a->glyph_count = 0;
+    if (a->glyphs) memset(a->glyphs, 0, sizeof(Glyph) * a->glyph_cap);
+}
+
+static void atlas_free(GlyphAtlas* a)
+{
+    atlas_drop_pages(a);
+    free(a->glyphs);
+    a->glyphs = NULL;
+    a->glyph_cap = 0;
+    a->renderer = NULL;
+}
+
 /* ------------------------------------------------------------------ */
 Font_ttf* load_font_ttf(const char* path, int ptsize)
 {
     TTF_Font* raw = TTF_OpenFont(path, ptsize);
     if (!raw) return NULL;
-    Font_ttf* f = malloc(sizeof *f);
-    if (!f) { TTF_CloseFont(raw); return NULL; }
-    f->font = raw;
-    return f;
+    return wrap_font(raw);
 }
 
 void free_font_ttf(Font_ttf* f)
 {
     if (!f) return;
+    for (Font_ttf** it = &live_fonts; *it; it = &(*it)->next_live) {
+        if (*it == f) { *it = f->next_live; break; }
+    }
+    text_cache_purge(f, NULL);
+    atlas_free(&f->atlas);
+    free(f->advances.ascii_kern);
+    free(f->advances.slots);
     if (f->font) TTF_CloseFont(f->font);
     free(f);
 }
 
+/* ------------------------------------------------------------------ */
+/*  Font registry                                                      */
+/* ------------------------------------------------------------------ */
+#define FONT_REGISTRY_IDLE_MAX 16   /* unreferenced fonts kept open */
+
+typedef struct {
+    char*       path;       /* file source (NULL for memory sources) */
+    const void* mem;        /* memory source                         */
+    int         mem_size;
+    Uint32      hash;       /* hash of path, or of (mem, size)       */
+    int         ptsize;
+    unsigned    dpi;
+    Font_ttf*   font;       /* NULL = open failed (negative entry)   */
+    int         refs;
+    Uint32      last_use;
+} FontEntry;
+
+static struct {
+    FontEntry* entries;
+    int        count;
+    int        cap;
+    Uint32     clock;
+} font_registry = {0};
+
+static Uint32 fnv1a(const char* s);
+
+static Uint32 mem_key_hash(const void* mem, int size)
+{
+    Uint32 h = (Uint32)(uintptr_t)mem * 2654435761u;
+    return h ^ ((Uint32)size * 40503u);
+}
+
+static int ensure_ttf_init(void)
+{
+    if (TTF_WasInit()) return 1;
+    if (TTF_Init() == -1) {
+        printf("TTF initialization failed: %s\n", TTF_GetError());
+        return 0;
+    }
+    return 1;
+}
+
+static void font_entry_close(FontEntry* e)
+{
+    if (e->font) free_font_ttf(e->font);
+    free(e->path);
+}
+
+/* Closes the least recently used unreferenced font once too many pile up. */
+static void font_registry_trim(void)
+{
+    int idle = 0, victim = -1;
+    for (int i = 0; i < font_registry.count; ++i) {
+        FontEntry* e = &font_registry.entries[i];
+        if (e->refs > 0 || !e->font) continue;
+        ++idle;
+        if (victim < 0 || e->last_use < font_registry.entries[victim].last_use) victim = i;
+    }
+    if (idle <= FONT_REGISTRY_IDLE_MAX || victim < 0) return;
+
+    font_entry_close(&font_registry.entries[victim]);
+    font_registry.entries[victim] = font_registry.entries[--font_registry.count];
+}
+
+static FontEntry* font_registry_find(const char* path, const void* mem, int size,
+                                     Uint32 hash, int ptsize, unsigned dpi)
+{
+    for (int i = 0; i < font_registry.count; ++i) {
+        FontEntry* e = &font_registry.entries[i];
+        if (e->hash != hash || e->ptsize != ptsize || e->dpi != dpi) continue;
+        if (path ? (e->path && strcmp(e->path, path) == 0)
+                 : (!e->path && e->mem == mem && e->mem_size == size))
+            return e;
+    }
+    return NULL;
+}
+
+static Font_ttf* font_registry_acquire(const char* path, const void* mem, int size,
+                                       int ptsize, unsigned dpi)
+{
+    Uint32 hash = path ? fnv1a(path) : mem_key_hash(mem, size);
+    FontEntry* e = font_registry_find(path, mem, size, hash, ptsize, dpi);
+
+    if (!e) {
+        if (!ensure_ttf_init()) return NULL;
+        font_registry_trim();
+
+        if (font_registry.count == font_registry.cap) {
+            int cap = font_registry.cap ? font_registry.cap * 2 : 8;
+            FontEntry* grown = realloc(font_registry.entries, sizeof(FontEntry) * cap);
+            if (!grown) return NULL;
+            font_registry.entries = grown;
+            font_registry.cap = cap;
+        }
+
+        TTF_Font* raw = NULL;
+        if (path) {
+            raw = dpi ? TTF_OpenFontDPI(path, ptsize, dpi, dpi) : TTF_OpenFont(path, ptsize);
+        } else {
+            SDL_RWops* rw = SDL_RWFromConstMem(mem, size);
+            if (rw) raw = dpi ? TTF_OpenFontDPIRW(rw, 1, ptsize, dpi, dpi)
+                              : TTF_OpenFontRW(rw, 1, ptsize);
+        }
+        if (!raw) {
+            printf("Failed to load font '%s' (%dpt): %s\n",
+                   path ? path : "<memory>", ptsize, TTF_GetError());
+        }
+
+        e = &font_registry.entries[font_registry.count++];
+        *e = (FontEntry){
+            .path = path ? strdup(path) : NULL, .mem = mem, .mem_size = size,
+            .hash = hash, .ptsize = ptsize, .dpi = dpi,
+            .font = raw ? wrap_font(raw) : NULL,
+        };
+    }
+
+    e->last_use = ++font_registry.clock;
+    if (!e->font) return NULL;
+    e->refs++;
+    return e->font;
+}
+
+Font_ttf* acquire_font_ttf(const char* path, int ptsize, unsigned dpi)
+{
+    if (!path) return NULL;
+    return font_registry_acquire(path, NULL, 0, ptsize, dpi);
+}
+
+Font_ttf* acquire_font_mem(const void* mem, int size, int ptsize, unsigned dpi)
+{
+    if (!mem || size <= 0) return NULL;
+    return font_registry_acquire(NULL, mem, size, ptsize, dpi);
+}
+
+void release_font_ttf(Font_ttf* f)
+{
+    if (!f) return;
+    for (int i = 0; i < font_registry.count; ++i) {
+        FontEntry* e = &font_registry.entries[i];
+        if (e->font == f) {
+            if (e->refs > 0) e->refs--;
+            return;
+        }
+    }
+}
+
+void preload_font_ttf(const char* path, int ptsize, unsigned dpi)
+{
+    release_font_ttf(acquire_font_ttf(path, ptsize, dpi));
+}
+
+void font_registry_clear(void)
+{
+    for (int i = 0; i < font_registry.count; ++i) {
+        font_entry_close(&font_registry.entries[i]);
+    }
+    free(font_registry.entries);
+    font_registry.entries = NULL;
+    font_registry.count = font_registry.cap = 0;
+}
+
+/* Terminated copy of a slice for the rasterizing fallback of
+ * draw_text_from_font_n; dropped with the text cache */
+static char* slice = NULL;
+static int   slice_cap = 0;
+
+static void slice_free(void)
+{
+    free(slice);
+    slice = NULL;
+    slice_cap = 0;
+}
+
+void ttf_release_renderer(SDL_Renderer* ren)
+{
+    text_cache_purge(NULL, ren);
+    slice_free();
+    for (Font_ttf* f = live_fonts; f; f = f->next_live) {
+        if (f->atlas.renderer == ren) {
+            atlas_drop_pages(&f->atlas);
+            f->atlas.renderer = NULL;
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Decode one UTF-8 sequence, advancing *s. Malformed input → U+FFFD.  */
+static Uint32 utf8_next(const char** s)
+{
+    const unsigned char* p = (const unsigned char*)*s;
+    Uint32 c = p[0];
+    int n = 0;
+
+    if      (c < 0x80)           { *s += 1; return c; }
+    else if ((c & 0xE0) == 0xC0) { c &= 0x1F; n = 1; }
+    else if ((c & 0xF0) == 0xE0) { c &= 0x0F; n = 2; }
+    else if ((c & 0xF8) == 0xF0) { c &= 0x07; n = 3; }
+    else                         { *s += 1; return 0xFFFD; }
+
+    for (int i = 1; i <= n; ++i) {
+        if ((p[i] & 0xC0) != 0x80) { *s += i; return 0xFFFD; }
+        c = (c << 6) | (p[i] & 0x3F);
+    }
+    *s += n + 1;
+    return c;
+}
+
+/* Advance table lookups (see the top of the file) */
+static int query_advance(Font_ttf* f, Uint32 cp)
+{
+    int advance = 0;
+    if (TTF_GlyphMetrics32(f->font, cp, NULL, NULL, NULL, NULL, &advance) != 0) advance = 0;
+    return advance;
+}
+
+static AdvanceSlot* advance_slot(AdvanceTable* t, Uint32 cp)
+{
+    Uint32 mask = (Uint32)t->cap - 1;
+    Uint32 i = (cp * 2654435761u) & mask;
+    while (t->slots[i].codepoint && t->slots[i].codepoint != cp)
+        i = (i + 1) & mask;
+    return &t->slots[i];
+}
+
+static int advance_grow(AdvanceTable* t)
+{
+    int old_cap = t->cap;
+    AdvanceSlot* old = t->slots;
+    int cap = old_cap ? old_cap * 2 : 64;
+
+    t->slots = calloc(cap, sizeof(AdvanceSlot));
+    if (!t->slots) { t->slots = old; return 0; }
+    t->cap = cap;
+    for (int i = 0; i < old_cap; ++i) {
+        if (old[i].codepoint) *advance_slot(t, old[i].codepoint) = old[i];
+    }
+    free(old);
+    return 1;
+}
+
+static int glyph_advance(Font_ttf* f, Uint32 cp)
+{
+    AdvanceTable* t = &f->advances;
+    if (cp < 128) {
+        if (t->ascii[cp] == ADVANCE_UNKNOWN) t->ascii[cp] = (Sint16)query_advance(f, cp);
+        return t->ascii[cp];
+    }
+
+    if (t->count * 4 >= t->cap * 3 && !advance_grow(t)) return query_advance(f, cp);
+    AdvanceSlot* slot = advance_slot(t, cp);
+    if (slot->codepoint != cp) {
+        slot->codepoint = cp;
+        slot->advance = (Sint16)query_advance(f, cp);
+        t->count++;
+    }
+    return slot->advance;
+}
+
+static int glyph_kerning(Font_ttf* f, Uint32 prev, Uint32 cp)
+{
+    if (!prev || !f->kerning) return 0;
+    if (prev >= 128 || cp >= 128) return TTF_GetFontKerningSizeGlyphs32(f->font, prev, cp);
+
+    AdvanceTable* t = &f->advances;
+    if (!t->ascii_kern) {
+        t->ascii_kern = malloc(128 * 128);
+        if (!t->ascii_kern) return TTF_GetFontKerningSizeGlyphs32(f->font, prev, cp);
+        memset(t->ascii_kern, KERN_UNKNOWN, 128 * 128);
+    }
+    Sint8* k = &t->ascii_kern[prev * 128 + cp];
+    if (*k == KERN_UNKNOWN) {
+        int kern = TTF_GetFontKerningSizeGlyphs32(f->font, prev, cp);
+        if (kern <= KERN_UNKNOWN || kern > 127) return kern;   /* doesn't fit, don't cache */
+        *k = (Sint8)kern;
+    }
+    return *k;
+}
+
+/* Walks the first `len` bytes of `text`, storing the caret x of every byte
+ * offset in out[0..len] (when out is non-NULL). Bytes inside a multi-byte
+ * sequence get the position after it. Returns the total width. */
+static int measure_prefixes(Font_ttf* f, const char* text, int len, int* out)
+{
+    int pen = 0;
+    Uint32 prev = 0;
+    const char* s = text;
+    const char* end = text + len;
+
+    while (s < end) {
+        int i = (int)(s - text);
+        Uint32 cp;
+        if ((unsigned char)*s < 0x80) {       /* ASCII fast path */
+            cp = (unsigned char)*s++;
+        } else {
+            cp = utf8_next(&s);
+            if (s > end) s = end;             /* sequence cut by len */
+        }
+
+        pen += glyph_kerning(f, prev, cp);
+        prev = cp;
+        if (out) out[i] = pen;
+        pen += glyph_advance(f, cp);
+        if (out) {
+            for (int j = i + 1; j < (int)(s - text); ++j) out[j] = pen;
+        }
+    }
+    if (out) out[len] = pen;
+    return pen;
+}
+
+static Glyph* atlas_slot(GlyphAtlas* a, Uint32 cp)
+{
+    Uint32 mask = (Uint32)a->glyph_cap - 1;
+    Uint32 i = (cp * 2654435761u) & mask;
+    while (a->glyphs[i].codepoint && a->glyphs[i].codepoint != cp)
+        i = (i + 1) & mask;
+    return &a->glyphs[i];
+}
+
+static int atlas_grow(GlyphAtlas* a)
+{
+    int old_cap = a->glyph_cap;
+    Glyph* old = a->glyphs;
+    int cap = old_cap ? old_cap * 2 : 256;
+
+    a->glyphs = calloc(cap, sizeof(Glyph));
+    if (!a->glyphs) { a->glyphs = old; return 0; }
+    a->glyph_cap = cap;
+    for (int i = 0; i < old_cap; ++i) {
+        if (old[i].codepoint) *atlas_slot(a, old[i].codepoint) = old[i];
+    }
+    free(old);
+    return 1;
+}
+
+/* Reserve a w×h cell; returns the page index or -1 if the atlas is full. */
+static int atlas_pack(GlyphAtlas* a, int w, int h, int* out_x, int* out_y)
+{
+    if (w + ATLAS_GLYPH_PAD > ATLAS_PAGE_SIZE || h + ATLAS_GLYPH_PAD > ATLAS_PAGE_SIZE)
+        return -1;
+
+    if (a->page_count > 0) {
+        if (a->shelf_x + w + ATLAS_GLYPH_PAD > ATLAS_PAGE_SIZE) {
+            a->shelf_y += a->shelf_h + ATLAS_GLYPH_PAD;
+            a->shelf_x = 0;
+            a->shelf_h = 0;
+        }
+        if (a->shelf_y + h + ATLAS_GLYPH_PAD <= ATLAS_PAGE_SIZE) {
+            *out_x = a->shelf_x;
+            *out_y = a->shelf_y;
+            a->shelf_x += w + ATLAS_GLYPH_PAD;
+            if (h > a->shelf_h) a->shelf_h = h;
+            return a->page_count - 1;
+        }
+    }
+
+    /* current page exhausted → open a new one */
+    if (a->page_count == ATLAS_MAX_PAGES) return -1;
+
+    profiler_count(AX_COUNTER_TEXTURE_CREATES, 1);
+    SDL_Texture* page = SDL_CreateTexture(a->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                          SDL_TEXTUREACCESS_STATIC,
+                                          ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+    if (!page) return -1;
+    SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+
+    /* clear once so linear filtering never samples garbage at cell edges */
+    void* zero = calloc((size_t)ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE, 4);
+    if (zero) {
+        SDL_UpdateTexture(page, NULL, zero, ATLAS_PAGE_SIZE * 4);
+        free(zero);
+    }
+
+    a->pages[a->page_count++] = page;
+    a->shelf_x = w + ATLAS_GLYPH_PAD;
+    a->shelf_y = 0;
+    a->shelf_h = h;
+    *out_x = 0;
+    *out_y = 0;
+    return a->page_count - 1;
+}
+
+/* Look up a glyph, rasterizing it into the atlas on first use.
+ * Returns NULL when the glyph cannot be made resident (atlas full). */
+static const Glyph* atlas_glyph(Font_ttf* f, Uint32 cp)
+{
+    GlyphAtlas* a = &f->atlas;
+
+    if (a->glyph_count * 4 >= a->glyph_cap * 3 && !atlas_grow(a)) return NULL;
+
+    Glyph* g = atlas_slot(a, cp);
+    if (g->codepoint == cp) return g;
+
+    int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+    if (TTF_GlyphMetrics32(f->font, cp, &minx, &maxx, &miny, &maxy, &advance) != 0) {
+        minx = maxx = miny = maxy = advance = 0;
+    }
+
+    Glyph ng = { .codepoint = cp, .page = -1, .advance = (Sint16)advance,
+                 .x_off = (Sint16)(minx < 0 ? minx : 0) };
+
+    if (maxx > minx && maxy > miny) {
+        SDL_Color white = { 255, 255, 255, 255 };
+        SDL_Surface* surf = TTF_RenderGlyph32_Blended(f->font, cp, white);
+        profiler_count(AX_COUNTER_RASTERIZATIONS, 1);
+        if (!surf) return NULL;
+
+        if (surf->format->format != SDL_PIXELFORMAT_ARGB8888) {
+            SDL_Surface* conv = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0);
+            SDL_FreeSurface(surf);
+            if (!conv) return NULL;
+            surf = conv;
+        }
+
+        int px = 0, py = 0;
+        int page = atlas_pack(a, surf->w, surf->h, &px, &py);
+        if (page < 0) { SDL_FreeSurface(surf); return NULL; }
+
+        SDL_Rect dst = { px, py, surf->w, surf->h };
+        SDL_UpdateTexture(a->pages[page], &dst, surf->pixels, surf->pitch);
+
+        ng.page = (Sint16)page;
+        ng.x = (Sint16)px;  ng.y = (Sint16)py;
+        ng.w = (Sint16)surf->w;  ng.h = (Sint16)surf->h;
+        SDL_FreeSurface(surf);
+    }
+
+    *g = ng;
+    a->glyph_count++;
+    return g;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Text layout into quads                                             */
+/* ------------------------------------------------------------------ */
+typedef struct {
+    float  x0, y0, x1, y1;
+    float  u0, v0, u1, v1;
+    int    page;
+} GlyphQuad;
+
+static GlyphQuad*  quad_buf   = NULL;
+static int         quad_cap   = 0;
+static SDL_Vertex* vert_buf   = NULL;
+static int*        index_buf  = NULL;
+static int         vert_cap   = 0;
+
+static int reserve_quads(int n)
+{
+    if (n <= quad_cap) return 1;
+    int cap = quad_cap ? quad_cap : 64;
+    while (cap < n) cap *= 2;
+
+    GlyphQuad*  q = realloc(quad_buf,  sizeof(GlyphQuad)  * cap);
+    if (!q) return 0;
+    quad_buf = q;
+    SDL_Vertex* v = realloc(vert_buf,  sizeof(SDL_Vertex) * cap * 4);
+    if (!v) return 0;
+    vert_buf = v;
+    int*        i = realloc(index_buf, sizeof(int)        * cap * 6);
+    if (!i) return 0;
+    index_buf = i;
+    quad_cap = vert_cap = cap;
+    return 1;
+}
+
+/* Lays out the first `len` bytes of `text` at the origin. Returns the quad
+ * count (or -1 if the atlas could not hold every glyph) and stores the pen
+ * advance in *width. */
+static int layout_glyphs(Font_ttf* f, const char* text, int len, int* width)
+{
+    int count = 0, pen = 0;
+    Uint32 prev = 0;
+    const float inv = 1.0f / ATLAS_PAGE_SIZE;
+    const char* end = text + len;
+
+    for (const char* s = text; s < end; ) {
+        Uint32 cp = (unsigned char)*s < 0x80 ? (Uint32)(unsigned char)*s++ : utf8_next(&s);
+        const Glyph* g = atlas_glyph(f, cp);
+        if (!g) return -1;
+
+        pen += glyph_kerning(f, prev, cp);
+        prev = cp;
+
+        if (g->page >= 0) {
+            if (!reserve_quads(count + 1)) return -1;
+            GlyphQuad* q = &quad_buf[count++];
+            q->x0 = (float)(pen + g->x_off);
+            q->y0 = 0.0f;
+            q->x1 = q->x0 + g->w;
+            q->y1 = (float)g->h;
+            q->u0 = g->x * inv;
+            q->v0 = g->y * inv;
+            q->u1 = (g->x + g->w) * inv;
+            q->v1 = (g->y + g->h) * inv;
+            q->page = g->page;
+        }
+        pen += g->advance;
+    }
+    *width = pen;
+    return count;
+}
+
+/* Records one draw-list primitive per atlas page touched by the quads;
+ * consecutive strings on the same page end up in a single draw call. */
+static void submit_quads(SDL_Renderer* ren, GlyphAtlas* a, int count,
+                         float dx, float dy, SDL_Color col)
+{
+    for (int page = 0; page < a->page_count; ++page) {
+        int n = 0;
+        for (int i = 0; i < count; ++i) {
+            const GlyphQuad* q = &quad_buf[i];
+            if (q->page != page) continue;
+
+            SDL_Vertex* v = &vert_buf[n * 4];
+            v[0] = (SDL_Vertex){ { q->x0 + dx, q->y0 + dy }, col, { q->u0, q->v0 } };
+            v[1] = (SDL_Vertex){ { q->x1 + dx, q->y0 + dy }, col, { q->u1, q->v0 } };
+            v[2] = (SDL_Vertex){ { q->x1 + dx, q->y1 + dy }, col, { q->u1, q->v1 } };
+            v[3] = (SDL_Vertex){ { q->x0 + dx, q->y1 + dy }, col, { q->u0, q->v1 } };
+
+            int* idx = &index_buf[n * 6];
+            int b = n * 4;
+            idx[0] = b; idx[1] = b + 1; idx[2] = b + 2;
+            idx[3] = b; idx[4] = b + 2; idx[5] = b + 3;
+            ++n;
+        }
+        if (n > 0)
+            batch_geometry(ren, a->pages[page], vert_buf, n * 4, index_buf, n * 6);
+    }
+}
+
+/* Draws through the atlas. Returns 0 if the caller must fall back to the
+ * one-shot render path (glyph larger than a page, out of memory, ...). */
+static int draw_text_atlas(SDL_Renderer* ren, Font_ttf* f, const char* text, int len,
+                           int x, int y, SDL_Color col, TextAlign align)
+{
+    GlyphAtlas* a = &f->atlas;
+    if (a->renderer != ren) {
+        atlas_drop_pages(a);
+        a->renderer = ren;
+    }
+
+    int width = 0;
+    int count = layout_glyphs(f, text, len, &width);
+    if (count < 0) {
+        /* atlas full – start over once with empty pages */
+        atlas_drop_pages(a);
+        count = layout_glyphs(f, text, len, &width);
+        if (count < 0) return 0;
+    }
+
+    int draw_x = x;
+    switch (align) {
+        case ALIGN_CENTER: draw_x = x - width / 2; break;
+        case ALIGN_RIGHT:  draw_x = x - width;     break;
+        case ALIGN_LEFT:
+        default:           break;
+    }
+
+    submit_quads(ren, a, count, (float)draw_x, (float)y, col);
+    return 1;
+}
+
 /* ------------------------------------------------------------------ */
 static SDL_Surface* render_surface(TTF_Font* font,
                                    const char* text,
@@ -56,9 +722,11 @@ TTF_TextResult render_text_ttf(SDL_Renderer*    ren,
         return res;
 
     SDL_Surface* surf = render_surface(font->font, utf8_text, mode, fg, bg);
+    profiler_count(AX_COUNTER_RASTERIZATIONS, 1);
     if (!surf) return res;
 
     SDL_Texture* tex = SDL_CreateTextureFromSurface(ren, surf);
+    profiler_count(AX_COUNTER_TEXTURE_CREATES, 1);
     if (tex) {
         res.texture = tex;
         res.w       = surf->w;
@@ -70,11 +738,198 @@ TTF_TextResult render_text_ttf(SDL_Renderer*    ren,
 }
 
 /* ------------------------------------------------------------------ */
+/*  Rendered-string cache (LRU, byte budget)                           */
+/* ------------------------------------------------------------------ */
+#define TEXT_CACHE_BUCKETS 1024   /* power of two */
+
+typedef struct TextCacheEntry {
+    SDL_Renderer*          ren;
+    Font_ttf*              font;
+    Uint32                 hash;
+    TTF_RenderMode         mode;
+    SDL_Color              fg, bg;
+    char*                  text;
+    TTF_TextResult         result;
+    size_t                 bytes;
+    struct TextCacheEntry* bucket_next;
+    struct TextCacheEntry* lru_prev;   /* towards most recently used  */
+    struct TextCacheEntry* lru_next;   /* towards least recently used */
+} TextCacheEntry;
+
+static struct {
+    TextCacheEntry* buckets[TEXT_CACHE_BUCKETS];
+    TextCacheEntry* lru_head;          /* most recently used  */
+    TextCacheEntry* lru_tail;          /* least recently used */
+    TTF_TextCacheStats stats;
+} text_cache = { .stats = { .budget = 8u * 1024u * 1024u } };
+
+static Uint32 fnv1a(const char* s)
+{
+    Uint32 h = 2166136261u;
+    while (*s) { h ^= (unsigned char)*s++; h *= 16777619u; }
+    return h;
+}
+
+static int same_color(SDL_Color a, SDL_Color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static void lru_unlink(TextCacheEntry* e)
+{
+    if (e->lru_prev) e->lru_prev->lru_next = e->lru_next; else text_cache.lru_head = e->lru_next;
+    if (e->lru_next) e->lru_next->lru_prev = e->lru_prev; else text_cache.lru_tail = e->lru_prev;
+    e->lru_prev = e->lru_next = NULL;
+}
+
+static void lru_push_front(TextCacheEntry* e)
+{
+    e->lru_prev = NULL;
+    e->lru_next = text_cache.lru_head;
+    if (text_cache.lru_head) text_cache.lru_head->lru_prev = e;
+    text_cache.lru_head = e;
+    if (!text_cache.lru_tail) text_cache.lru_tail = e;
+}
+
+static void text_cache_remove(TextCacheEntry* e)
+{
+    TextCacheEntry** it = &text_cache.buckets[e->hash & (TEXT_CACHE_BUCKETS - 1)];
+    while (*it && *it != e) it = &(*it)->bucket_next;
+    if (*it) *it = e->bucket_next;
+
+    lru_unlink(e);
+    text_cache.stats.bytes -= e->bytes;
+    text_cache.stats.entries--;
+    free_ttf_result(&e->result);
+    free(e->text);
+    free(e);
+}
+
+static void text_cache_trim(size_t budget)
+{
+    while (text_cache.stats.bytes > budget && text_cache.lru_tail) {
+        text_cache_remove(text_cache.lru_tail);
+        text_cache.stats.evictions++;
+    }
+}
+
+/* Drops every entry that references `font` or `ren` (NULL = any). */
+static void text_cache_purge(const Font_ttf* font, const SDL_Renderer* ren)
+{
+    TextCacheEntry* e = text_cache.lru_head;
+    while (e) {
+        TextCacheEntry* next = e->lru_next;
+        if ((font && e->font == font) || (ren && e->ren == ren)) text_cache_remove(e);
+        e = next;
+    }
+}
+
+TTF_TextResult render_text_ttf_cached(SDL_Renderer*    ren,
+                                      Font_ttf*        font,
+                                      const char*      utf8_text,
+                                      TTF_RenderMode   mode,
+                                      SDL_Color        fg,
+                                      SDL_Color        bg)
+{
+    TTF_TextResult none = { .texture = NULL, .w = 0, .h = 0 };
+    if (!ren || !font || !utf8_text || utf8_text[0] == '\0') return none;
+
+    Uint32 hash = fnv1a(utf8_text);
+    TextCacheEntry** bucket = &text_cache.buckets[hash & (TEXT_CACHE_BUCKETS - 1)];
+
+    for (TextCacheEntry* e = *bucket; e; e = e->bucket_next) {
+        if (e->hash == hash && e->ren == ren && e->font == font && e->mode == mode &&
+            same_color(e->fg, fg) && (mode != TTF_RENDER_SHADED || same_color(e->bg, bg)) &&
+            strcmp(e->text, utf8_text) == 0) {
+            lru_unlink(e);
+            lru_push_front(e);
+            text_cache.stats.hits++;
+            return e->result;
+        }
+    }
+
+    text_cache.stats.misses++;
+    TTF_TextResult res = render_text_ttf(ren, font, utf8_text, mode, fg, bg);
+    if (!res.texture) return res;
+
+    TextCacheEntry* e = calloc(1, sizeof *e);
+    char* copy = strdup(utf8_text);
+    if (!e || !copy) {
+        free(e);
+        free(copy);
+        SDL_DestroyTexture(res.texture);   /* nothing would ever free it */
+        printf("Failed to cache text texture\n");
+        return none;
+    }
+    e->ren = ren;  e->font = font;  e->hash = hash;  e->mode = mode;
+    e->fg = fg;    e->bg = bg;      e->text = copy; e->result = res;
+    e->bytes = (size_t)res.w * (size_t)res.h * 4;
+
+    /* make room first so the new entry is never its own victim */
+    if (e->bytes < text_cache.stats.budget)
+        text_cache_trim(text_cache.stats.budget - e->bytes);
+
+    e->bucket_next = *bucket;
+    *bucket = e;
+    lru_push_front(e);
+    text_cache.stats.bytes += e->bytes;
+    text_cache.stats.entries++;
+    return res;
+}
+
+void ttf_text_cache_stats(TTF_TextCacheStats* out)
+{
+    if (out) *out = text_cache.stats;
+}
+
+void ttf_text_cache_set_budget(size_t bytes)
+{
+    text_cache.stats.budget = bytes;
+    text_cache_trim(bytes);
+}
+
+void ttf_text_cache_clear(void)
+{
+    while (text_cache.lru_head) text_cache_remove(text_cache.lru_head);
+    slice_free();
+}
+
+/* ------------------------------------------------------------------ */
+int ttf_measure_prefix_widths_n(Font_ttf* f, const char* text, int len, int* out_offsets)
+{
+    if (!f || !f->font || !text || len < 0) {
+        if (out_offsets) out_offsets[0] = 0;
+        return 0;
+    }
+    return measure_prefixes(f, text, len, out_offsets);
+}
+
+int ttf_measure_prefix_widths(Font_ttf* f, const char* text, int* out_offsets)
+{
+    return ttf_measure_prefix_widths_n(f, text, text ? (int)strlen(text) : 0, out_offsets);
+}
+
+int ttf_caret_at_x(const char* text, const int* offsets, int len, int x)
+{
+    int pos = 0;
+    while (pos < len) {
+        int next = pos + 1;   /* past the continuation bytes */
+        while (next < len && ((unsigned char)text[next] & 0xC0) == 0x80) next++;
+        int char_w = offsets[next] - offsets[pos];
+        if (offsets[pos] + char_w / 2 > x) break;
+        pos = next;
+    }
+    return pos;
+}
+
+int ttf_text_width_n(Font_ttf* f, const char* text, int len)
+{
+    return ttf_measure_prefix_widths_n(f, text, len, NULL);
+}
+
 int ttf_text_width(Font_ttf* f, const char* text)
 {
-    int w = 0;
-    if (f && f->font && text) TTF_SizeUTF8(f->font, text, &w, NULL);
-    return w;
+    return ttf_measure_prefix_widths(f, text, NULL);
 }
 
 int ttf_text_height(Font_ttf* f, const char* text)
@@ -134,16 +989,39 @@ int ttf_size_utf8(Font_ttf* f, const char* text, int* w, int* h)
 void draw_text_from_font(Base* base, void* font_ptr, const char* text,
                                  int x, int y, Color color, TextAlign align)
 {
-	Font_ttf* font = (Font_ttf*)font_ptr;
-    if (!font || !text || text[0] == '\0') {
+    if (!font_ptr || !text || text[0] == '\0') {
         printf("Invalid font or empty text\n");
         return;
     }
+    draw_text_from_font_n(base, font_ptr, text, (int)strlen(text), x, y, color, align);
+}
+
+void draw_text_from_font_n(Base* base, void* font_ptr, const char* text, int len,
+                           int x, int y, Color color, TextAlign align)
+{
+	Font_ttf* font = (Font_ttf*)font_ptr;
+    if (!font || !text || len <= 0) return;
 
     SDL_Color fg = { color.r, color.g, color.b, color.a };
     SDL_Color bg = { 0, 0, 0, 0 };  // not used in SOLID
 
-    // Use SOLID for speed (aliased), or BLENDED for smooth
+    // Fast path: glyphs come from the font's atlas, no rasterization
+    if (draw_text_atlas(base->sdl_renderer, font, text, len, x, y, fg, align)) {
+        return;
+    }
+
+    // Fallback: rasterize the whole string once (huge point sizes etc.).
+    // SDL_ttf wants a terminated string, so only this path copies the slice.
+    if (len + 1 > slice_cap) {
+        char* grown = realloc(slice, len + 1);
+        if (!grown) return;
+        slice = grown;
+        slice_cap = len + 1;
+    }
+    memcpy(slice, text, len);
+    slice[len] = '\0';
+    text = slice;
+
     TTF_TextResult result = render_text_ttf(
         base->sdl_renderer,
         font,
@@ -172,32 +1050,56 @@ void draw_text_from_font(Base* base, void* font_ptr, const char* text,
     }
 
     SDL_Rect dst = { draw_x, y, result.w, result.h };
-    SDL_RenderCopy(base->sdl_renderer, result.texture, NULL, &dst);
+    batch_texture(base->sdl_renderer, result.texture, NULL, &dst, (SDL_Color){255, 255, 255, 255});
 
-    // Clean up texture
+    // Clean up texture (flushes the draw list first)
     free_ttf_result(&result);
 }
 
-void draw_text(Base* base, const char* text, int font_size, int x, int y, Color color) {
-    Font_ttf* font = load_font_ttf(current_theme->font_file, font_size);
-    if (!font) {
-        printf("Failed to load font '%s': %s\n",current_theme->font_file , TTF_GetError());
+void draw_text_cached(Base* base, void* font_ptr, const char* text,
+                      int x, int y, Color color, TextAlign align)
+{
+    Font_ttf* font = (Font_ttf*)font_ptr;
+    if (!font || !text || text[0] == '\0') {
+        printf("Invalid font or empty text\n");
+        return;
+    }
+
+    SDL_Color fg = { color.r, color.g, color.b, color.a };
+    SDL_Color bg = { 0, 0, 0, 0 };
+    TTF_TextResult result = render_text_ttf_cached(base->sdl_renderer, font, text,
+                                                   TTF_RENDER_BLENDED, fg, bg);
+    if (!result.texture) {
+        printf("Failed to render text (TTF error hidden in wrapper)\n");
         return;
     }
 
+    int draw_x = x;
+    switch (align) {
+        case ALIGN_CENTER: draw_x = x - result.w / 2; break;
+        case ALIGN_RIGHT:  draw_x = x - result.w;     break;
+        case ALIGN_LEFT:
+        default:           break;
+    }
+
+    SDL_Rect dst = { draw_x, y, result.w, result.h };
+    batch_texture(base->sdl_renderer, result.texture, NULL, &dst, (SDL_Color){255, 255, 255, 255});
+}
+
+void draw_text(Base* base, const char* text, int font_size, int x, int y, Color color) {
+    Font_ttf* font = acquire_font_ttf(current_theme->font_file, font_size, 0);
+    if (!font) return;   // failure already reported once by the registry
+
     draw_text_from_font(base, font, text, x, y, color, ALIGN_LEFT);
-    free_font_ttf(font);
+    release_font_ttf(font);
 }
 
 void draw_icon(Base* base, const char* icon, int font_size, int x, int y, Color color){
-    Font_ttf* font = load_font_ttf("../axo/asset/icons/MaterialSymbolsOutlined-Regular.ttf", font_size);
-    if (!font) {
-        printf("Failed to load font '%s': %s\n",current_theme->font_file , TTF_GetError());
-        return;
-    }
+    Font_ttf* font = acquire_font_ttf(ICON_FONT_FILE, font_size, 0);
+    if (!font) return;
 
     draw_text_from_font(base, font, icon, x, y, color, ALIGN_LEFT);
-    free_font_ttf(font);
+    release_font_ttf(font);
 }
 
 
@@ -223,8 +1125,5 @@ RWops* open_font_rw(const void *mem, int size) {
 Font_ttf* load_font_rw(RWops * rw, int font_size){
 	TTF_Font* raw = TTF_OpenFontRW(rw->handle, 1, font_size);
 	if(!raw) return NULL;
-    Font_ttf* f = malloc(sizeof *f);
-    if (!f) { TTF_CloseFont(raw); return NULL; }
-    f->font = raw;
-    return f;
+    return wrap_font(raw);
 }
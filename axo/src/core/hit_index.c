@@ -0,0 +1,241 @@
+#include "../../include/core/hit_index.h"
+#include <stdlib.h>
+#include <string.h>
+
+static struct {
+    HitEntry* entries;
+    int       count, cap;
+
+    // Grid in CSR form: cell c owns items[cell_start[c] .. cell_start[c + 1]),
+    // entry indices in ascending (paint) order
+    int*      cell_start;
+    int       cell_cap;
+    int*      items;
+    int       item_cap;
+    int       origin_x, origin_y;
+    int       cell_size;
+    int       cols, rows;
+
+    bool      valid;
+} hit = {0};
+
+// Routing state. The widget pointer survives rebuilds; the entry index is
+// resolved again by hit_index_end.
+typedef struct {
+    void* widget;
+    int   index;
+} HitRef;
+
+static const HitRef no_ref = { NULL, -1 };
+static HitRef hovered  = { NULL, -1 };   // topmost widget under the pointer at the last pointer event
+static HitRef captured = { NULL, -1 };   // widget that got the last left mouse down, until mouse up
+static HitRef focused  = { NULL, -1 };   // widget that got the last mouse down
+
+/* ---------- building ---------- */
+static bool grow(void** buf, int* cap, int need, size_t elem) {
+    if (need <= *cap) return true;
+    int new_cap = *cap ? *cap : 64;
+    while (new_cap < need) new_cap *= 2;
+    void* grown = realloc(*buf, elem * new_cap);
+    if (!grown) return false;
+    *buf = grown;
+    *cap = new_cap;
+    return true;
+}
+
+void hit_index_begin(void) {
+    hit.count = 0;
+    hit.cols = hit.rows = 0;
+    hit.valid = false;
+}
+
+void hit_index_add(Rect bounds, void* widget, HitUpdateFn update, axProfilePhase phase, int flags) {
+    if (!widget || !update) return;
+    if (!grow((void**)&hit.entries, &hit.cap, hit.count + 1, sizeof(HitEntry))) return;
+    if (bounds.w < 0) bounds.w = 0;
+    if (bounds.h < 0) bounds.h = 0;
+    hit.entries[hit.count++] = (HitEntry){ bounds, widget, update, phase, flags };
+}
+
+// Cell range covered by a rect (inclusive), clamped to the grid
+static void cell_span(const Rect* r, int* c0, int* r0, int* c1, int* r1) {
+    *c0 = (r->x - hit.origin_x) / hit.cell_size;
+    *r0 = (r->y - hit.origin_y) / hit.cell_size;
+    *c1 = (r->x + r->w - hit.origin_x) / hit.cell_size;
+    *r1 = (r->y + r->h - hit.origin_y) / hit.cell_size;
+    if (*c1 >= hit.cols) *c1 = hit.cols - 1;
+    if (*r1 >= hit.rows) *r1 = hit.rows - 1;
+}
+
+static HitRef ref_of(const HitEntry* e) {
+    return e ? (HitRef){ e->widget, (int)(e - hit.entries) } : no_ref;
+}
+
+// Widgets that were not re-added are gone (freed, parent closed)
+static void resolve(HitRef* ref) {
+    if (!ref->widget) return;
+    for (int i = 0; i < hit.count; i++) {
+        if (hit.entries[i].widget == ref->widget) {
+            ref->index = i;
+            return;
+        }
+    }
+    *ref = no_ref;
+}
+
+void hit_index_end(void) {
+    hit.valid = true;
+    resolve(&hovered);
+    resolve(&captured);
+    resolve(&focused);
+
+    // The grid spans the union of all hittable bounds
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    bool any = false;
+    for (int i = 0; i < hit.count; i++) {
+        const Rect* r = &hit.entries[i].bounds;
+        if (r->w == 0 || r->h == 0) continue;
+        if (!any || r->x < x0) x0 = r->x;
+        if (!any || r->y < y0) y0 = r->y;
+        if (!any || r->x + r->w > x1) x1 = r->x + r->w;
+        if (!any || r->y + r->h > y1) y1 = r->y + r->h;
+        any = true;
+    }
+    if (!any) return;
+
+    hit.origin_x = x0;
+    hit.origin_y = y0;
+    hit.cell_size = HIT_CELL_SIZE;
+    for (;;) {
+        hit.cols = (x1 - x0) / hit.cell_size + 1;
+        hit.rows = (y1 - y0) / hit.cell_size + 1;
+        if (hit.cols * hit.rows <= HIT_MAX_CELLS) break;
+        hit.cell_size *= 2;
+    }
+    int cells = hit.cols * hit.rows;
+    if (!grow((void**)&hit.cell_start, &hit.cell_cap, cells + 1, sizeof(int))) {
+        hit.cols = hit.rows = 0;
+        return;
+    }
+
+    // Count, prefix-sum, fill
+    memset(hit.cell_start, 0, sizeof(int) * (cells + 1));
+    int total = 0;
+    for (int i = 0; i < hit.count; i++) {
+        const Rect* r = &hit.entries[i].bounds;
+        if (r->w == 0 || r->h == 0) continue;
+        int c0, r0, c1, r1;
+        cell_span(r, &c0, &r0, &c1, &r1);
+        for (int row = r0; row <= r1; row++)
+            for (int col = c0; col <= c1; col++) hit.cell_start[row * hit.cols + col + 1]++;
+        total += (c1 - c0 + 1) * (r1 - r0 + 1);
+    }
+    for (int c = 0; c < cells; c++) hit.cell_start[c + 1] += hit.cell_start[c];
+    if (!grow((void**)&hit.items, &hit.item_cap, total, sizeof(int))) {
+        hit.cols = hit.rows = 0;
+        return;
+    }
+
+    for (int i = 0; i < hit.count; i++) {
+        const Rect* r = &hit.entries[i].bounds;
+        if (r->w == 0 || r->h == 0) continue;
+        int c0, r0, c1, r1;
+        cell_span(r, &c0, &r0, &c1, &r1);
+        for (int row = r0; row <= r1; row++)
+            for (int col = c0; col <= c1; col++) hit.items[hit.cell_start[row * hit.cols + col]++] = i;
+    }
+    // The fill advanced every start to the next cell's; shift them back
+    for (int c = cells; c > 0; c--) hit.cell_start[c] = hit.cell_start[c - 1];
+    hit.cell_start[0] = 0;
+}
+
+bool hit_index_valid(void) {
+    return hit.valid;
+}
+
+void hit_index_invalidate(void) {
+    hit.valid = false;
+}
+
+/* ---------- queries ---------- */
+const HitEntry* hit_index_at(int x, int y) {
+    if (hit.cols == 0 || x < hit.origin_x || y < hit.origin_y) return NULL;
+    int col = (x - hit.origin_x) / hit.cell_size;
+    int row = (y - hit.origin_y) / hit.cell_size;
+    if (col >= hit.cols || row >= hit.rows) return NULL;
+
+    int c = row * hit.cols + col;
+    for (int k = hit.cell_start[c + 1] - 1; k >= hit.cell_start[c]; k--) {
+        const HitEntry* e = &hit.entries[hit.items[k]];
+        // Inclusive edges, like the widgets' own hit tests
+        if (x >= e->bounds.x && x <= e->bounds.x + e->bounds.w &&
+            y >= e->bounds.y && y <= e->bounds.y + e->bounds.h) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/* ---------- dispatch ---------- */
+static void deliver(const HitEntry* e, axEvent* event) {
+    profiler_begin(e->phase);
+    e->update(e->widget, event);
+    profiler_end(e->phase);
+    if (e->flags & HIT_MOVES_LAYOUT) hit.valid = false;
+}
+
+void hit_index_dispatch(axEvent* event) {
+    HitRef targets[3];
+    int n = 0;
+
+    switch (event->type) {
+        case EVENT_MOUSEMOTION: {
+            HitRef under = ref_of(hit_index_at(event->mouseMove.x, event->mouseMove.y));
+            targets[n++] = captured;
+            targets[n++] = under;
+            targets[n++] = hovered;     // lets it clear its hover state
+            hovered = under;
+            break;
+        }
+        case EVENT_MOUSEBUTTONDOWN: {
+            HitRef under = ref_of(hit_index_at(event->mouseButton.x, event->mouseButton.y));
+            targets[n++] = focused;     // first, so it can let go before the new one takes over
+            targets[n++] = under;
+            targets[n++] = captured;
+            hovered = under;
+            focused = under;
+            if (event->mouseButton.button == MOUSE_LEFT) captured = under;
+            break;
+        }
+        case EVENT_MOUSEBUTTONUP: {
+            HitRef under = ref_of(hit_index_at(event->mouseButton.x, event->mouseButton.y));
+            targets[n++] = captured;
+            targets[n++] = under;
+            hovered = under;
+            if (event->mouseButton.button == MOUSE_LEFT) captured = no_ref;
+            break;
+        }
+        case EVENT_MOUSEWHEEL:
+            targets[n++] = hovered;
+            break;
+        case EVENT_KEYDOWN:
+        case EVENT_KEYUP:
+        case EVENT_TEXTINPUT:
+            targets[n++] = focused;
+            break;
+        default:
+            return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (!targets[i].widget) continue;
+        bool seen = false;
+        for (int j = 0; j < i; j++) seen = seen || targets[j].widget == targets[i].widget;
+        if (!seen) deliver(&hit.entries[targets[i].index], event);
+    }
+
+    // Clicks run callbacks that may add, move or hide widgets
+    if (event->type == EVENT_MOUSEBUTTONDOWN || event->type == EVENT_MOUSEBUTTONUP) {
+        hit.valid = false;
+    }
+}
@@ -0,0 +1,127 @@
+#include "../../include/core/intern.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct Chunk {
+    struct Chunk* next;
+    size_t        used, size;
+    char          data[];
+} Chunk;
+
+static struct {
+    Chunk*       chunks;   // newest first; only the head takes new strings
+    const char** slots;    // open-addressed set of interned strings, cap is a power of two
+    uint32_t*    hashes;   // hash of each slot, so probes rarely touch the string
+    int          count, cap;
+} pool = {0};
+
+/* ---------- hashing ---------- */
+static uint32_t hash_string(const char* s, size_t len) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int find_slot(const char* s, size_t len, uint32_t h) {
+    int mask = pool.cap - 1;
+    for (int i = (int)(h & mask);; i = (i + 1) & mask) {
+        if (!pool.slots[i]) return i;
+        if (pool.hashes[i] == h && strncmp(pool.slots[i], s, len) == 0 && pool.slots[i][len] == '\0') return i;
+    }
+}
+
+// Keeps the table at most half full
+static bool reserve(void) {
+    if (pool.count * 2 < pool.cap) return true;
+    int old_cap = pool.cap;
+    const char** old_slots = pool.slots;
+    uint32_t* old_hashes = pool.hashes;
+
+    int cap = old_cap ? old_cap * 2 : 64;
+    const char** slots = calloc(cap, sizeof(*slots));
+    uint32_t* hashes = calloc(cap, sizeof(*hashes));
+    if (!slots || !hashes) {
+        free(slots);
+        free(hashes);
+        return false;
+    }
+    pool.slots = slots;
+    pool.hashes = hashes;
+    pool.cap = cap;
+    for (int i = 0; i < old_cap; i++) {
+        if (!old_slots[i]) continue;
+        int mask = cap - 1, j = (int)(old_hashes[i] & mask);
+        while (pool.slots[j]) j = (j + 1) & mask;
+        pool.slots[j] = old_slots[i];
+        pool.hashes[j] = old_hashes[i];
+    }
+    free(old_slots);
+    free(old_hashes);
+    return true;
+}
+
+/* ---------- arena ---------- */
+static char* arena_copy(const char* s, size_t len) {
+    Chunk* c = pool.chunks;
+    if (!c || c->size - c->used < len + 1) {
+        size_t size = len + 1 > INTERN_CHUNK_SIZE ? len + 1 : INTERN_CHUNK_SIZE;
+        c = malloc(sizeof(Chunk) + size);
+        if (!c) return NULL;
+        c->size = size;
+        c->used = 0;
+        // An oversized string gets its own chunk behind the head, so the
+        // head's free space stays usable
+        if (size > INTERN_CHUNK_SIZE && pool.chunks) {
+            c->next = pool.chunks->next;
+            pool.chunks->next = c;
+        } else {
+            c->next = pool.chunks;
+            pool.chunks = c;
+        }
+    }
+    char* out = c->data + c->used;
+    memcpy(out, s, len);
+    out[len] = '\0';
+    c->used += len + 1;
+    return out;
+}
+
+/* ---------- public API ---------- */
+const char* intern_string(const char* s) {
+    if (!s) return NULL;
+    if (!reserve()) {
+        printf("Failed to intern string\n");
+        return NULL;
+    }
+    size_t len = strlen(s);
+    uint32_t h = hash_string(s, len);
+    int i = find_slot(s, len, h);
+    if (pool.slots[i]) return pool.slots[i];
+
+    char* copy = arena_copy(s, len);
+    if (!copy) {
+        printf("Failed to intern string\n");
+        return NULL;
+    }
+    pool.slots[i] = copy;
+    pool.hashes[i] = h;
+    pool.count++;
+    return copy;
+}
+
+void intern_reset(void) {
+    while (pool.chunks) {
+        Chunk* next = pool.chunks->next;
+        free(pool.chunks);
+        pool.chunks = next;
+    }
+    free(pool.slots);
+    free(pool.hashes);
+    memset(&pool, 0, sizeof(pool));
+}
@@ -1,5 +1,6 @@
 #include "../../include/core/parent.h"
 #include <stdio.h>
+#include <math.h>
 
 
 // Returns DPI scale relative to standard 96 DPI
@@ -17,6 +18,7 @@ axParent axCreateWindow(char* title, int w, int h) {
     parent.color = COLOR_GRAY;
     parent.is_open = true;
     parent.title_height=0;
+    parent.geom_gen = 0;
 
 	create_window(&parent.base,title, w,h);
 	
@@ -24,11 +26,30 @@ axParent axCreateWindow(char* title, int w, int h) {
 }
 
 
+axParent axCreateHeadlessWindow(int w, int h) {
+	axParent parent = {0};
+    parent.is_window = 1;
+    parent.w = w;
+    parent.h = h;
+    parent.color = COLOR_GRAY;
+    parent.is_open = true;
+    parent.title_height = 0;
+
+	headless_create(&parent.base, w, h);
+
+    return parent;
+}
+
+
 void free_parent(axParent* parent) {
     if (!parent) return;
 
     if (parent->is_window) {
-        destroy_window(&parent->base);
+        if (parent->base.sdl_window) {
+            destroy_window(&parent->base);
+        } else {
+            headless_destroy(&parent->base);   // root without a window is headless
+        }
     }
 
 }
@@ -37,3 +58,72 @@ Rect get_parent_rect(const axParent *p)
 {
     return (Rect){ .x = p->x, .y = p->y, .w = p->w, .h = p->h };
 }
+
+unsigned parent_geometry(axParent *p)
+{
+    float dpi = p->base.dpi_scale;
+    if (p->geom_gen && p->geom_key_dpi == dpi &&
+        p->geom_key.x == p->x && p->geom_key.y == p->y &&
+        p->geom_key.w == p->w && p->geom_key.h == p->h &&
+        p->geom_key_title == p->title_height && p->geom_key_zone == p->resize_zone) {
+        return p->geom_gen;
+    }
+    p->phys = (Rect){ (int)roundf(p->x * dpi), (int)roundf(p->y * dpi),
+                      (int)roundf(p->w * dpi), (int)roundf(p->h * dpi) };
+    p->phys_title_height = (int)roundf(p->title_height * dpi);
+    p->phys_resize_zone  = (int)roundf(p->resize_zone * dpi);
+    p->geom_key = get_parent_rect(p);
+    p->geom_key_title = p->title_height;
+    p->geom_key_zone  = p->resize_zone;
+    p->geom_key_dpi   = dpi;
+    if (++p->geom_gen == 0) p->geom_gen = 1;
+    return p->geom_gen;
+}
+
+const Rect* parent_clip_rect(axParent *p)
+{
+    if (p->is_window) return NULL;
+    parent_geometry(p);
+    return &p->phys;
+}
+
+const Rect* widget_geom(axGeomCache *c, axParent *p, int x, int y, int w, int h)
+{
+    unsigned gen = parent_geometry(p);
+    if (c->parent_gen != gen || c->parent != p ||
+        c->key.x != x || c->key.y != y || c->key.w != w || c->key.h != h) {
+        float dpi = p->base.dpi_scale;
+        c->rect = (Rect){ (int)roundf((x + p->x) * dpi), (int)roundf((y + p->y + p->title_height) * dpi),
+                          (int)roundf(w * dpi), (int)roundf(h * dpi) };
+        c->key = (Rect){ x, y, w, h };
+        c->parent = p;
+        c->parent_gen = gen;
+    }
+    return &c->rect;
+}
+
+Rect widget_screen_rect(axParent *p, int x, int y, int w, int h)
+{
+    float dpi = p->base.dpi_scale;
+    Rect r = { (int)roundf((x + p->x) * dpi), (int)roundf((y + p->y + p->title_height) * dpi),
+               (int)roundf(w * dpi), (int)roundf(h * dpi) };
+    if (!clip_to_parent(p, &r)) return (Rect){ 0, 0, 0, 0 };
+    return r;
+}
+
+Rect widget_visible_rect(axGeomCache *c, axParent *p, int x, int y, int w, int h)
+{
+    Rect r = *widget_geom(c, p, x, y, w, h);
+    if (!clip_to_parent(p, &r)) return (Rect){ 0, 0, 0, 0 };
+    return r;
+}
+
+bool clip_to_parent(axParent *p, Rect *r)
+{
+    const Rect *clip = parent_clip_rect(p);
+    if (!clip) return r->w > 0 && r->h > 0;
+    Rect visible;
+    if (!rect_intersect(clip, r, &visible)) return false;
+    *r = visible;
+    return true;
+}
@@ -0,0 +1,139 @@
+#include "../../include/core/profiler.h"
+#include <SDL2/SDL.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool profiler_enabled = false;
+static bool overlay_visible = false;
+
+static const char* phase_names[AX_PHASE_COUNT] = {
+    "poll",
+    "update containers", "update radios", "update entries", "update textboxes",
+    "update sliders", "update buttons", "update texts", "update dropdowns",
+    "update progress", "update images",
+    "render containers", "render dropdowns", "render radios", "render entries",
+    "render textboxes", "render sliders", "render buttons", "render texts",
+    "render progress", "render images", "image upload",
+    "present", "frame"
+};
+
+static const char* counter_names[AX_COUNTER_COUNT] = {
+    "draw calls", "texture creates", "rasterizations", "widgets culled",
+    "motion merged"
+};
+
+static struct {
+    Uint64 started[AX_PHASE_COUNT];   // perf counter at begin, 0 = not running
+    Uint64 accum[AX_PHASE_COUNT];     // ticks spent this frame
+    int    counts[AX_COUNTER_COUNT];  // events this frame
+
+    float  phase_ms[PROFILER_HISTORY][AX_PHASE_COUNT];
+    int    counter_hist[PROFILER_HISTORY][AX_COUNTER_COUNT];
+    int    head;                      // next slot to write
+    int    filled;
+} prof;
+
+void axProfilerEnable(bool enabled) {
+    if (enabled && !profiler_enabled) axProfilerReset();
+    profiler_enabled = enabled;
+}
+
+bool axProfilerIsEnabled(void) {
+    return profiler_enabled;
+}
+
+void axProfilerSetOverlay(bool visible) {
+    overlay_visible = visible;
+    if (visible) axProfilerEnable(true);
+}
+
+bool axProfilerOverlayVisible(void) {
+    return overlay_visible;
+}
+
+void axProfilerReset(void) {
+    memset(&prof, 0, sizeof prof);
+}
+
+const char* axProfilerPhaseName(axProfilePhase phase) {
+    return (phase >= 0 && phase < AX_PHASE_COUNT) ? phase_names[phase] : "?";
+}
+
+const char* axProfilerCounterName(axProfileCounter counter) {
+    return (counter >= 0 && counter < AX_COUNTER_COUNT) ? counter_names[counter] : "?";
+}
+
+/* ---------- recording ---------- */
+void profiler_begin_(axProfilePhase phase) {
+    prof.started[phase] = SDL_GetPerformanceCounter();
+}
+
+void profiler_end_(axProfilePhase phase) {
+    if (!prof.started[phase]) return;
+    prof.accum[phase] += SDL_GetPerformanceCounter() - prof.started[phase];
+    prof.started[phase] = 0;
+}
+
+void profiler_count_(axProfileCounter counter, int n) {
+    prof.counts[counter] += n;
+}
+
+void profiler_frame_begin(void) {
+    if (!profiler_enabled) return;
+    memset(prof.accum, 0, sizeof prof.accum);
+    memset(prof.counts, 0, sizeof prof.counts);
+    profiler_begin_(AX_PHASE_FRAME);
+}
+
+void profiler_frame_end(int rendered) {
+    if (!profiler_enabled) return;
+    profiler_end_(AX_PHASE_FRAME);
+    if (!rendered) return;
+
+    double to_ms = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    for (int i = 0; i < AX_PHASE_COUNT; i++) {
+        prof.phase_ms[prof.head][i] = (float)(prof.accum[i] * to_ms);
+    }
+    memcpy(prof.counter_hist[prof.head], prof.counts, sizeof prof.counts);
+
+    prof.head = (prof.head + 1) % PROFILER_HISTORY;
+    if (prof.filled < PROFILER_HISTORY) prof.filled++;
+}
+
+/* ---------- queries ---------- */
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// samples is sorted in place
+static void fill_stats(double* samples, int n, double last, axProfileStats* out) {
+    out->last = last;
+    out->p50 = out->p99 = 0.0;
+    if (n == 0) return;
+    qsort(samples, n, sizeof(double), cmp_double);
+    out->p50 = samples[(n - 1) * 50 / 100];
+    out->p99 = samples[(n - 1) * 99 / 100];
+}
+
+void axProfilerGetPhase(axProfilePhase phase, axProfileStats* out) {
+    if (!out) return;
+    memset(out, 0, sizeof *out);
+    if (phase < 0 || phase >= AX_PHASE_COUNT || prof.filled == 0) return;
+
+    double samples[PROFILER_HISTORY];
+    for (int i = 0; i < prof.filled; i++) samples[i] = prof.phase_ms[i][phase];
+    int last = (prof.head + PROFILER_HISTORY - 1) % PROFILER_HISTORY;
+    fill_stats(samples, prof.filled, prof.phase_ms[last][phase], out);
+}
+
+void axProfilerGetCounter(axProfileCounter counter, axProfileStats* out) {
+    if (!out) return;
+    memset(out, 0, sizeof *out);
+    if (counter < 0 || counter >= AX_COUNTER_COUNT || prof.filled == 0) return;
+
+    double samples[PROFILER_HISTORY];
+    for (int i = 0; i < prof.filled; i++) samples[i] = prof.counter_hist[i][counter];
+    int last = (prof.head + PROFILER_HISTORY - 1) % PROFILER_HISTORY;
+    fill_stats(samples, prof.filled, prof.counter_hist[last][counter], out);
+}
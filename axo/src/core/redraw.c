@@ -0,0 +1,96 @@
+#include "../../include/core/redraw.h"
+#include <math.h>
+
+static axRedrawMode redraw_mode = AX_REDRAW_CONTINUOUS;
+
+static struct {
+    Rect rects[REDRAW_MAX_RECTS];
+    int  count;
+    bool full;
+} damage = {0};
+
+void axSetRedrawMode(axRedrawMode mode) {
+    redraw_mode = mode;
+    axInvalidateAll();  // the first on-demand frame has to paint everything
+}
+
+axRedrawMode axGetRedrawMode(void) {
+    return redraw_mode;
+}
+
+/* ---------- rect helpers ---------- */
+static bool rects_touch(const Rect* a, const Rect* b) {
+    return a->x <= b->x + b->w && b->x <= a->x + a->w &&
+           a->y <= b->y + b->h && b->y <= a->y + a->h;
+}
+
+static Rect rect_union(const Rect* a, const Rect* b) {
+    int x0 = a->x < b->x ? a->x : b->x;
+    int y0 = a->y < b->y ? a->y : b->y;
+    int x1 = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    int y1 = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+    return (Rect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+/* ---------- invalidation ---------- */
+void axInvalidateRect(Rect r) {
+    if (redraw_mode != AX_REDRAW_ON_DEMAND || damage.full) return;
+    if (r.w <= 0 || r.h <= 0) return;
+
+    // Fold into any rect it overlaps; the grown rect may now reach others
+    int i = 0;
+    while (i < damage.count) {
+        if (rects_touch(&damage.rects[i], &r)) {
+            r = rect_union(&damage.rects[i], &r);
+            damage.rects[i] = damage.rects[--damage.count];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    if (damage.count == REDRAW_MAX_RECTS) {
+        // Too fragmented: one bounding box is cheaper than many passes
+        for (i = 0; i < damage.count; i++) r = rect_union(&damage.rects[i], &r);
+        damage.count = 0;
+    }
+    damage.rects[damage.count++] = r;
+}
+
+void axInvalidateWidget(const axParent* parent, int x, int y, int w, int h) {
+    if (redraw_mode != AX_REDRAW_ON_DEMAND || !parent) return;
+
+    float dpi = parent->base.dpi_scale;
+    int abs_x = x + parent->x;
+    int abs_y = y + parent->y + parent->title_height;
+
+    // Pad by a pixel on each side to cover rounding and anti-aliased edges
+    Rect r = {
+        (int)roundf(abs_x * dpi) - 1,
+        (int)roundf(abs_y * dpi) - 1,
+        (int)roundf(w * dpi) + 2,
+        (int)roundf(h * dpi) + 2
+    };
+    axInvalidateRect(r);
+}
+
+void axInvalidateAll(void) {
+    damage.full = true;
+    damage.count = 0;
+}
+
+bool axIsDirty(void) {
+    return damage.full || damage.count > 0;
+}
+
+int redraw_take_damage(Rect* out, int full_w, int full_h) {
+    int n = 0;
+    if (damage.full) {
+        out[n++] = (Rect){ 0, 0, full_w, full_h };
+    } else {
+        for (int i = 0; i < damage.count; i++) out[n++] = damage.rects[i];
+    }
+    damage.full = false;
+    damage.count = 0;
+    return n;
+}
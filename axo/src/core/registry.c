@@ -0,0 +1,191 @@
+#include "../../include/core/registry.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    int      dense;        // index into entries, -1 when free
+    unsigned generation;
+    int      next_free;    // free list link, -1 = end
+} Slot;
+
+static struct {
+    axWidgetEntry* entries;   // draw order once compacted
+    int            count, cap;
+    Slot*          slots;
+    int            slot_count, slot_cap;
+    int            free_slot; // head of the free list, -1 = none
+    unsigned       next_seq;
+    bool           holes;     // some entries were unregistered
+    bool           unsorted;  // z order needs restoring
+} reg = { .free_slot = -1 };
+
+/* ---------- storage ---------- */
+static bool grow(void** buf, int* cap, int need, size_t elem) {
+    if (need <= *cap) return true;
+    int new_cap = *cap ? *cap : 64;
+    while (new_cap < need) new_cap *= 2;
+    void* grown = realloc(*buf, elem * new_cap);
+    if (!grown) return false;
+    *buf = grown;
+    *cap = new_cap;
+    return true;
+}
+
+static Slot* slot_of(axWidgetHandle h) {
+    if (h.generation == 0 || h.index >= (unsigned)reg.slot_count) return NULL;
+    Slot* s = &reg.slots[h.index];
+    return (s->generation == h.generation && s->dense >= 0) ? s : NULL;
+}
+
+static int compare_entries(const void* a, const void* b) {
+    const axWidgetEntry* x = a;
+    const axWidgetEntry* y = b;
+    if (x->z != y->z) return x->z < y->z ? -1 : 1;
+    return x->seq < y->seq ? -1 : x->seq > y->seq;
+}
+
+// Drops unregistered entries and restores z order, then repoints the slots
+static void compact(void) {
+    if (!reg.holes && !reg.unsorted) return;
+    if (reg.holes) {
+        int n = 0;
+        for (int i = 0; i < reg.count; i++) {
+            if (reg.entries[i].widget) reg.entries[n++] = reg.entries[i];
+        }
+        reg.count = n;
+    }
+    if (reg.unsorted) qsort(reg.entries, reg.count, sizeof(axWidgetEntry), compare_entries);
+    for (int i = 0; i < reg.count; i++) reg.slots[reg.entries[i].slot].dense = i;
+    reg.holes = reg.unsorted = false;
+}
+
+/* ---------- public API ---------- */
+axWidgetHandle axRegisterWidget(void* widget, const axWidgetClass* cls) {
+    axWidgetHandle none = { 0, 0 };
+    if (!widget || !cls) return none;
+    if (!grow((void**)&reg.entries, &reg.cap, reg.count + 1, sizeof(axWidgetEntry))) {
+        printf("Failed to register %s widget\n", cls->name);
+        return none;
+    }
+
+    int slot = reg.free_slot;
+    if (slot >= 0) {
+        reg.free_slot = reg.slots[slot].next_free;
+    } else {
+        if (!grow((void**)&reg.slots, &reg.slot_cap, reg.slot_count + 1, sizeof(Slot))) {
+            printf("Failed to register %s widget\n", cls->name);
+            return none;
+        }
+        slot = reg.slot_count++;
+        reg.slots[slot].generation = 0;
+    }
+    Slot* s = &reg.slots[slot];
+    s->generation++;
+    if (s->generation == 0) s->generation = 1;   // 0 marks invalid handles
+    s->dense = reg.count;
+    s->next_free = -1;
+
+    if (reg.count > 0 && cls->default_z < reg.entries[reg.count - 1].z) reg.unsorted = true;
+    reg.entries[reg.count++] = (axWidgetEntry){ widget, cls, cls->default_z, reg.next_seq++, (unsigned)slot, true };
+    return (axWidgetHandle){ (unsigned)slot, s->generation };
+}
+
+bool axUnregisterWidget(axWidgetHandle handle) {
+    Slot* s = slot_of(handle);
+    if (!s) return false;
+    axWidgetEntry* e = &reg.entries[s->dense];
+    if (e->cls->unregistered) e->cls->unregistered(e->widget);
+    e->widget = NULL;   // compacted on the next walk
+    reg.holes = true;
+    s->dense = -1;
+    s->generation++;
+    s->next_free = reg.free_slot;
+    reg.free_slot = (int)handle.index;
+    return true;
+}
+
+void* axGetWidget(axWidgetHandle handle) {
+    Slot* s = slot_of(handle);
+    return s ? reg.entries[s->dense].widget : NULL;
+}
+
+void axSetWidgetZ(axWidgetHandle handle, int z) {
+    Slot* s = slot_of(handle);
+    if (!s || reg.entries[s->dense].z == z) return;
+    reg.entries[s->dense].z = z;
+    reg.unsorted = true;
+}
+
+const axWidgetEntry* axGetWidgets(int* count) {
+    compact();
+    if (count) *count = reg.count;
+    return reg.entries;
+}
+
+/* ---------- walks ---------- */
+void registry_cull(const Rect* view) {
+    compact();
+    int culled = 0;
+    for (int i = 0; i < reg.count; i++) {
+        axWidgetEntry* e = &reg.entries[i];
+        if (!e->widget || !e->cls->extent) continue;
+        Rect r, visible;
+        e->visible = e->cls->extent(e->widget, &r) && rect_intersect(view, &r, &visible);
+        culled += !e->visible;
+    }
+    profiler_count(AX_COUNTER_WIDGETS_CULLED, culled);
+}
+
+// Widgets of one class usually sit next to each other, so the profiler
+// phase only switches when the class does
+void axRenderAllWidgets(void) {
+    compact();
+    int phase = -1;
+    for (int i = 0; i < reg.count; i++) {
+        const axWidgetEntry* e = &reg.entries[i];
+        if (!e->widget || !e->visible || !e->cls->render) continue;
+        if ((int)e->cls->render_phase != phase) {
+            if (phase >= 0) profiler_end((axProfilePhase)phase);
+            phase = e->cls->render_phase;
+            profiler_begin((axProfilePhase)phase);
+        }
+        e->cls->render(e->widget);
+    }
+    if (phase >= 0) profiler_end((axProfilePhase)phase);
+}
+
+void axUpdateAllWidgets(axEvent* event) {
+    compact();
+    for (int i = 0; i < reg.count; i++) {
+        const axWidgetEntry* e = &reg.entries[i];
+        if (!e->widget || !e->cls->update) continue;
+        PROFILED(e->cls->update_phase, e->cls->update(e->widget, event));
+    }
+}
+
+void registry_render_class(const axWidgetClass* cls) {
+    compact();
+    for (int i = 0; i < reg.count; i++) {
+        if (reg.entries[i].widget && reg.entries[i].cls == cls) cls->render(reg.entries[i].widget);
+    }
+}
+
+void registry_update_class(const axWidgetClass* cls, axEvent* event) {
+    compact();
+    for (int i = 0; i < reg.count; i++) {
+        if (reg.entries[i].widget && reg.entries[i].cls == cls) cls->update(reg.entries[i].widget, event);
+    }
+}
+
+void axFreeAllWidgets(const axWidgetClass* cls) {
+    compact();
+    for (int i = 0; i < reg.count; i++) {
+        axWidgetEntry* e = &reg.entries[i];
+        if (!e->widget || (cls && e->cls != cls)) continue;
+        void* widget = e->widget;
+        const axWidgetClass* owner = e->cls;
+        axUnregisterWidget((axWidgetHandle){ e->slot, reg.slots[e->slot].generation });
+        if (owner->free) owner->free(widget);
+    }
+    compact();
+}
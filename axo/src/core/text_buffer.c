@@ -0,0 +1,241 @@
+#include "../../include/core/text_buffer.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TEXT_BUFFER_MIN_CAP  64
+#define TEXT_COALESCE_MAX    4    // edits up to one UTF-8 character merge into the last step
+
+/* ---------- gap management ---------- */
+static int gap_size(const TextBuffer* tb) {
+    return tb->gap_end - tb->gap_start;
+}
+
+static void move_gap(TextBuffer* tb, int pos) {
+    if (pos < tb->gap_start) {
+        int n = tb->gap_start - pos;
+        memmove(tb->data + tb->gap_end - n, tb->data + pos, n);
+        tb->gap_start -= n;
+        tb->gap_end -= n;
+    } else if (pos > tb->gap_start) {
+        int n = pos - tb->gap_start;
+        memmove(tb->data + tb->gap_start, tb->data + tb->gap_end, n);
+        tb->gap_start += n;
+        tb->gap_end += n;
+    }
+}
+
+// Grows the gap to hold n bytes plus the spare byte text_buffer_cstr writes its NUL into
+static bool ensure_gap(TextBuffer* tb, int n) {
+    if (gap_size(tb) >= n + 1) return true;
+
+    int cap = tb->cap * 2;
+    if (cap < tb->length + n + 1 + TEXT_BUFFER_MIN_CAP) cap = tb->length + n + 1 + TEXT_BUFFER_MIN_CAP;
+    char* grown = (char*)realloc(tb->data, cap);
+    if (!grown) return false;
+
+    int tail = tb->cap - tb->gap_end;
+    memmove(grown + cap - tail, grown + tb->gap_end, tail);
+    tb->data = grown;
+    tb->gap_end = cap - tail;
+    tb->cap = cap;
+    return true;
+}
+
+// The edit itself, without touching the undo log
+static bool apply(TextBuffer* tb, int pos, int remove_len, const char* s, int n) {
+    move_gap(tb, pos);
+    if (!ensure_gap(tb, n - remove_len > 0 ? n - remove_len : 0)) return false;
+    tb->gap_end += remove_len;
+    if (n) memcpy(tb->data + tb->gap_start, s, n);
+    tb->gap_start += n;
+    tb->length += n - remove_len;
+    return true;
+}
+
+/* ---------- undo log ---------- */
+static void edit_free(TextEdit* e) {
+    free(e->removed);
+    free(e->inserted);
+}
+
+static void history_clear(TextBuffer* tb) {
+    for (int i = 0; i < tb->history_count; i++) edit_free(&tb->history[i]);
+    tb->history_count = 0;
+    tb->undo_top = 0;
+    tb->coalesce = false;
+}
+
+static char* dup_bytes(const char* s, int n) {
+    if (n <= 0) return NULL;
+    char* copy = (char*)malloc(n);
+    if (copy) memcpy(copy, s, n);
+    return copy;
+}
+
+// Folds a small edit into the previous step (typing a word, holding backspace)
+static bool try_coalesce(TextBuffer* tb, int pos, int remove_len, const char* s, int n) {
+    if (!tb->coalesce || tb->undo_top == 0 || tb->undo_top != tb->history_count) return false;
+    if (n > TEXT_COALESCE_MAX || remove_len > TEXT_COALESCE_MAX || (n && memchr(s, '\n', n))) return false;
+    TextEdit* last = &tb->history[tb->undo_top - 1];
+
+    if (remove_len == 0 && last->removed_len == 0 && pos == last->pos + last->inserted_len) {
+        char* grown = (char*)realloc(last->inserted, last->inserted_len + n);
+        if (!grown) return false;
+        memcpy(grown + last->inserted_len, s, n);
+        last->inserted = grown;
+        last->inserted_len += n;
+        return true;
+    }
+    if (n == 0 && last->inserted_len == 0 &&
+        (pos + remove_len == last->pos || pos == last->pos)) {
+        char* grown = (char*)realloc(last->removed, last->removed_len + remove_len);
+        if (!grown) return false;
+        if (pos < last->pos) {   // backspace: the new bytes go in front
+            memmove(grown + remove_len, grown, last->removed_len);
+            for (int i = 0; i < remove_len; i++) grown[i] = text_buffer_at(tb, pos + i);
+            last->pos = pos;
+        } else {                 // delete: they go after
+            for (int i = 0; i < remove_len; i++) grown[last->removed_len + i] = text_buffer_at(tb, pos + i);
+        }
+        last->removed = grown;
+        last->removed_len += remove_len;
+        return true;
+    }
+    return false;
+}
+
+static void record(TextBuffer* tb, int pos, int remove_len, const char* s, int n) {
+    if (try_coalesce(tb, pos, remove_len, s, n)) return;
+
+    if (!tb->history) {
+        tb->history = (TextEdit*)calloc(TEXT_UNDO_DEPTH, sizeof(TextEdit));
+        if (!tb->history) return;
+    }
+    // A new edit forgets whatever could have been redone
+    for (int i = tb->undo_top; i < tb->history_count; i++) edit_free(&tb->history[i]);
+    tb->history_count = tb->undo_top;
+
+    if (tb->history_count == TEXT_UNDO_DEPTH) {
+        edit_free(&tb->history[0]);
+        memmove(tb->history, tb->history + 1, sizeof(TextEdit) * (TEXT_UNDO_DEPTH - 1));
+        tb->history_count--;
+    }
+
+    TextEdit e = { pos, NULL, remove_len, dup_bytes(s, n), n };
+    if (remove_len > 0) {
+        e.removed = (char*)malloc(remove_len);
+        if (e.removed) {
+            for (int i = 0; i < remove_len; i++) e.removed[i] = text_buffer_at(tb, pos + i);
+        }
+    }
+    if ((remove_len > 0 && !e.removed) || (n > 0 && !e.inserted)) {
+        edit_free(&e);
+        history_clear(tb);   // an incomplete log would undo into garbage
+        return;
+    }
+    tb->history[tb->history_count++] = e;
+    tb->undo_top = tb->history_count;
+}
+
+/* ---------- public API ---------- */
+bool text_buffer_init(TextBuffer* tb, int max_length) {
+    memset(tb, 0, sizeof(*tb));
+    tb->max_length = max_length > 0 ? max_length : 0;
+    tb->data = (char*)malloc(TEXT_BUFFER_MIN_CAP);
+    if (!tb->data) return false;
+    tb->cap = TEXT_BUFFER_MIN_CAP;
+    tb->gap_end = tb->cap;
+    return true;
+}
+
+void text_buffer_free(TextBuffer* tb) {
+    if (!tb) return;
+    history_clear(tb);
+    free(tb->history);
+    free(tb->data);
+    memset(tb, 0, sizeof(*tb));
+}
+
+bool text_buffer_replace(TextBuffer* tb, int pos, int remove_len, const char* s, int n) {
+    if (!tb->data || pos < 0 || remove_len < 0 || n < 0 || pos + remove_len > tb->length) return false;
+    if (remove_len == 0 && n == 0) return true;
+    if (tb->max_length && tb->length - remove_len + n > tb->max_length) return false;
+    if (!ensure_gap(tb, n)) return false;   // fail before the log records anything
+
+    record(tb, pos, remove_len, s, n);
+    apply(tb, pos, remove_len, s, n);
+    tb->coalesce = n <= TEXT_COALESCE_MAX && remove_len <= TEXT_COALESCE_MAX &&
+                   !(n && memchr(s, '\n', n));
+    return true;
+}
+
+bool text_buffer_insert(TextBuffer* tb, int pos, const char* s, int n) {
+    return text_buffer_replace(tb, pos, 0, s, n);
+}
+
+void text_buffer_erase(TextBuffer* tb, int pos, int n) {
+    text_buffer_replace(tb, pos, n, NULL, 0);
+}
+
+bool text_buffer_set(TextBuffer* tb, const char* s) {
+    int n = s ? (int)strlen(s) : 0;
+    if (tb->max_length && n > tb->max_length) n = tb->max_length;
+    history_clear(tb);
+    tb->gap_start = 0;
+    tb->gap_end = tb->cap;
+    tb->length = 0;
+    return apply(tb, 0, 0, s, n);
+}
+
+char text_buffer_at(const TextBuffer* tb, int i) {
+    return i < tb->gap_start ? tb->data[i] : tb->data[i + gap_size(tb)];
+}
+
+const char* text_buffer_range(TextBuffer* tb, int start, int len) {
+    if (start < tb->gap_start && start + len > tb->gap_start) {
+        // Straddles the gap: move it to whichever end of the range is nearer
+        if (tb->gap_start - start <= start + len - tb->gap_start) move_gap(tb, start);
+        else move_gap(tb, start + len);
+    }
+    return start < tb->gap_start ? tb->data + start : tb->data + start + gap_size(tb);
+}
+
+const char* text_buffer_cstr(TextBuffer* tb) {
+    if (!tb->data) return "";
+    move_gap(tb, tb->length);
+    tb->data[tb->length] = '\0';
+    return tb->data;
+}
+
+void text_buffer_copy(const TextBuffer* tb, int start, int len, char* out) {
+    if (!out) return;
+    int before = start < tb->gap_start ? tb->gap_start - start : 0;
+    if (before > len) before = len;
+    memcpy(out, tb->data + start, before);
+    memcpy(out + before, tb->data + start + before + gap_size(tb), len - before);
+    out[len] = '\0';
+}
+
+bool text_buffer_undo(TextBuffer* tb, TextChange* out) {
+    if (tb->undo_top == 0) return false;
+    TextEdit* e = &tb->history[tb->undo_top - 1];
+    if (!apply(tb, e->pos, e->inserted_len, e->removed, e->removed_len)) return false;
+    tb->undo_top--;
+    tb->coalesce = false;
+    if (out) *out = (TextChange){ e->pos, e->inserted_len, e->removed_len, e->pos + e->removed_len };
+    return true;
+}
+
+bool text_buffer_redo(TextBuffer* tb, TextChange* out) {
+    if (tb->undo_top == tb->history_count) return false;
+    TextEdit* e = &tb->history[tb->undo_top];
+    if (!apply(tb, e->pos, e->removed_len, e->inserted, e->inserted_len)) return false;
+    tb->undo_top++;
+    tb->coalesce = false;
+    if (out) *out = (TextChange){ e->pos, e->removed_len, e->inserted_len, e->pos + e->inserted_len };
+    return true;
+}
+
+void text_buffer_break_undo(TextBuffer* tb) {
+    tb->coalesce = false;
+}
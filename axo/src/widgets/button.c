@@ -2,6 +2,7 @@
 #include "../../include/widgets/button.h"
 #include "../../include/core/theme.h"
 #include "../../axo.h"
+#include "../../include/core/intern.h"
 #include "../../include/core/parent.h"    // <-- for Rect
 
 #include <stdlib.h>
@@ -27,7 +28,7 @@ axButton axCreateButton(axParent* parent, int x, int y, int w, int h,
     axButton b = {0};
     b.parent = parent;
     b.x = x; b.y = y; b.w = w; b.h = h;
-    b.label = label ? strdup(label) : NULL;
+    b.label = intern_string(label);
     b.callback = callback;
     return b;
 }
@@ -35,14 +36,14 @@ axButton axCreateButton(axParent* parent, int x, int y, int w, int h,
 /* --------------------------------------------------------------------- */
 void axSetButtonBgColor(axButton* b, Color c) {
     if (!b) return;
-    if (!b->custom_bg_color) b->custom_bg_color = malloc(sizeof(Color));
-    if (b->custom_bg_color) *b->custom_bg_color = c;
+    b->custom_bg_color = COLOR_OVERRIDE(c);
+    axInvalidateWidget(b->parent, b->x, b->y, b->w, b->h);
 }
 
 void axSetButtonTextColor(axButton* b, Color c) {
     if (!b) return;
-    if (!b->custom_text_color) b->custom_text_color = malloc(sizeof(Color));
-    if (b->custom_text_color) *b->custom_text_color = c;
+    b->custom_text_color = COLOR_OVERRIDE(c);
+    axInvalidateWidget(b->parent, b->x, b->y, b->w, b->h);
 }
 
 /* --------------------------------------------------------------------- */
@@ -52,39 +53,33 @@ void axRenderButton(axButton* b)
     if (!global_font) return;
 
     Base* base = &b->parent->base;
-    float dpi = base->dpi_scale;
 
     /* ---------- DPI-SCALED BUTTON BOUNDS ---------- */
-    int abs_x = b->x + b->parent->x;
-    int abs_y = b->y + b->parent->y + b->parent->title_height;
 
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(b->w * dpi);
-    int sh = (int)roundf(b->h * dpi);
+    const Rect* g = widget_geom(&b->geom, b->parent, b->x, b->y, b->w, b->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
 
     // Rect button_rect = { sx, sy, sw, sh };
 
-    /* ---------- PARENT CLIPPING (for containers) ---------- */
-    if (!b->parent->is_window) {
-        Rect pr = get_parent_rect(b->parent);           // our own Rect
-        pr.x = (int)roundf(pr.x * dpi);
-        pr.y = (int)roundf(pr.y * dpi);
-        pr.w = (int)roundf(pr.w * dpi);
-        pr.h = (int)roundf(pr.h * dpi);
-        clip_begin(base, &pr);
-    } else {
-        clip_begin(base, NULL);  // no clipping for root window
+    /* ---------- PARENT CLIPPING + CULLING ---------- */
+    clip_begin(base, parent_clip_rect(b->parent));
+    Rect extent = { sx, sy, sw, sh };
+    if (!clip_visible(base, &extent)) {
+        clip_end(base);
+        return;
     }
 
     /* ---------- BACKGROUND COLOR (state-aware) ---------- */
-    Color bg = b->custom_bg_color ? *b->custom_bg_color : current_theme->button_normal;
+    Color bg = color_or(b->custom_bg_color, current_theme->button_normal);
     if (b->is_pressed) {
-        bg = b->custom_bg_color ? darken_color(*b->custom_bg_color, 0.2f)
-                                : current_theme->button_pressed;
+        bg = b->custom_bg_color.set ? darken_color(b->custom_bg_color.color, 0.2f)
+                                    : current_theme->button_pressed;
     } else if (b->is_hovered) {
-        bg = b->custom_bg_color ? lighten_color(*b->custom_bg_color, 0.1f)
-                                : current_theme->button_hovered;
+        bg = b->custom_bg_color.set ? lighten_color(b->custom_bg_color.color, 0.1f)
+                                    : current_theme->button_hovered;
     }
 
     /* ---------- DRAW ROUNDED RECT ---------- */
@@ -97,8 +92,8 @@ void axRenderButton(axButton* b)
         int text_h = current_theme->default_font_size;
         int text_x = sx + (sw - text_w) / 2;
         int text_y = sy + (sh - text_h) / 2;
-        Color txt_col = b->custom_text_color ? *b->custom_text_color : current_theme->button_text;
-        draw_text_from_font(base, global_font, b->label, text_x, text_y, txt_col, ALIGN_LEFT);
+        Color txt_col = color_or(b->custom_text_color, current_theme->button_text);
+        draw_text_cached(base, global_font, b->label, text_x, text_y, txt_col, ALIGN_LEFT);
     }
 
     /* ---------- RESTORE CLIP ---------- */
@@ -110,15 +105,15 @@ void axUpdateButton(axButton* b, axEvent* ev)
 {
     if (!b || !b->parent || !b->parent->is_open) return;
 
-    float dpi = b->parent->base.dpi_scale;
-
     /* ---------- PHYSICAL BOUNDS FOR MOUSE ---------- */
-    int abs_x = b->x + b->parent->x;
-    int abs_y = b->y + b->parent->y + b->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(b->w * dpi);
-    int sh = (int)roundf(b->h * dpi);
+    const Rect* g = widget_geom(&b->geom, b->parent, b->x, b->y, b->w, b->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
+
+    int was_hovered = b->is_hovered;
+    int was_pressed = b->is_pressed;
 
     int mouse_x, mouse_y;
     input_get_mouse(&mouse_x, &mouse_y);
@@ -137,48 +132,50 @@ void axUpdateButton(axButton* b, axEvent* ev)
         }
         b->is_pressed = false;
     }
+
+    if (b->is_hovered != was_hovered || b->is_pressed != was_pressed) {
+        axInvalidateWidget(b->parent, b->x, b->y, b->w, b->h);
+    }
 }
 
 /* --------------------------------------------------------------------- */
 void axFreeButton(axButton* b)
 {
-    if (!b) return;
-    free(b->label);
-    free(b->custom_bg_color);
-    free(b->custom_text_color);
+    (void)b;   // label is interned and colors are inline: nothing to release
 }
 
 /* --------------------------------------------------------------------- */
-/* Registration (unchanged) */
+/* Registration */
 /* --------------------------------------------------------------------- */
-axButton* button_widgets[MAX_BUTTONS];
-int buttons_count = 0;
+static void button_update(void* w, axEvent* ev) { axUpdateButton((axButton*)w, ev); }
+static void button_render(void* w) { axRenderButton((axButton*)w); }
 
-void axRegisterButton(axButton* b)
+static bool button_bounds(void* w, Rect* out)
 {
-    if (buttons_count < MAX_BUTTONS)
-        button_widgets[buttons_count++] = b;
+    axButton* b = (axButton*)w;
+    if (!b->parent || !b->parent->is_open) return false;
+    *out = widget_visible_rect(&b->geom, b->parent, b->x, b->y, b->w, b->h);
+    return true;
 }
 
+const axWidgetClass button_class = {
+    "button", button_update, button_render, NULL, button_bounds, button_bounds,
+    AX_PHASE_UPDATE_BUTTONS, AX_PHASE_RENDER_BUTTONS, AX_Z_WIDGETS, 0
+};
+
+axWidgetHandle axRegisterButton(axButton* b)
+{
+    return axRegisterWidget(b, &button_class);
+}
 void axRenderAllRegisteredButtons(void)
 {
-    for (int i = 0; i < buttons_count; ++i)
-        if (button_widgets[i]) axRenderButton(button_widgets[i]);
+    registry_render_class(&button_class);
 }
-
 void axUpdateAllRegisteredButtons(axEvent* ev)
 {
-    for (int i = 0; i < buttons_count; ++i)
-        if (button_widgets[i]) axUpdateButton(button_widgets[i], ev);
+    registry_update_class(&button_class, ev);
 }
-
 void axFreeAllRegisteredButtons(void)
 {
-    for (int i = 0; i < buttons_count; ++i) {
-        if (button_widgets[i]) {
-            axFreeButton(button_widgets[i]);
-            button_widgets[i] = NULL;
-        }
-    }
-    buttons_count = 0;
+    axFreeAllWidgets(&button_class);
 }
@@ -1,5 +1,6 @@
 #include"../../include/widgets/container.h"
 #include"../../include/core/theme.h"
+#include"../../include/core/hit_index.h"
 #include"../../axo.h"
 #include"../../asset/icons/iconunicode.h"
 
@@ -37,6 +38,7 @@ axParent axCreateContainer(axParent* root, int x, int y, int w, int h) {
     parent.resize_zone = 5;
     parent.is_open = true;
     parent.title_height = 0;
+    parent.geom_gen = 0;   // physical geometry computed on first use
 
     return parent;
 }
@@ -49,6 +51,7 @@ void axSetContainerProperties(axParent* container, bool moveable, const char* ti
     container->closeable = closeable;
     container->resizeable = false; // should be assigned to resizeable, but feature is off for now
     container->title_height = has_title_bar ? 30 : 0;
+    axInvalidateAll();   // the title bar moves every child
 }
 
 void draw_title_bar_(axParent* container) {
@@ -60,10 +63,11 @@ void draw_title_bar_(axParent* container) {
     }
 
     float dpi = container->base.dpi_scale;
-    int sx = (int)roundf(container->x * dpi);
-    int sy = (int)roundf(container->y * dpi);
-    int sw = (int)roundf(container->w * dpi);
-    int sth = (int)roundf(container->title_height * dpi);
+    parent_geometry(container);
+    int sx = container->phys.x;
+    int sy = container->phys.y;
+    int sw = container->phys.w;
+    int sth = container->phys_title_height;
     int pad = (int)roundf(current_theme->padding * dpi);
 
     draw_rect(&container->base,
@@ -76,11 +80,11 @@ void draw_title_bar_(axParent* container) {
         	// handle erorr
         }
 
-        draw_text_from_font(&container->base, global_font,
-                   container->title_bar,
-                   sx + pad,
-                   sy + pad / 2,  // Approximate vertical centering
-                   current_theme->text_primary, ALIGN_LEFT);  // Use theme text color
+        draw_text_cached(&container->base, global_font,
+                         container->title_bar,
+                         sx + pad,
+                         sy + pad / 2,  // Approximate vertical centering
+                         current_theme->text_primary, ALIGN_LEFT);  // Use theme text color
     }
 
     if (container->closeable) {
@@ -103,11 +107,14 @@ void axRenderContainer(axParent* container) {
         current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
     }
 
-    float dpi = container->base.dpi_scale;
-    int sx = (int)roundf(container->x * dpi);
-    int body_y = (int)roundf((container->y + container->title_height) * dpi);
-    int sw = (int)roundf(container->w * dpi);
-    int body_h = (int)roundf((container->h - container->title_height) * dpi);
+    // Nothing of it inside the area being repainted
+    if (!clip_visible(&container->base, parent_clip_rect(container))) return;
+
+    const Rect* g = parent_clip_rect(container);
+    int sx = g->x;
+    int body_y = g->y + container->phys_title_height;
+    int sw = g->w;
+    int body_h = g->h - container->phys_title_height;
 
     draw_title_bar_(container);
 
@@ -124,17 +131,21 @@ void axUpdateContainer(axParent* container, axEvent* event) {
     if (!container || !container->is_open) return;
 
     float dpi = container->base.dpi_scale;
-    // Scale bounds to physical
-    int s_x = (int)roundf(container->x * dpi);
-    int s_y = (int)roundf(container->y * dpi);
-    int s_w = (int)roundf(container->w * dpi);
-    int s_h = (int)roundf(container->h * dpi);
-    int s_title_h = (int)roundf(container->title_height * dpi);
-    int s_resize_zone = (int)roundf(container->resize_zone * dpi);
+    // Physical bounds, cached until the container moves or resizes
+    parent_geometry(container);
+    int s_x = container->phys.x;
+    int s_y = container->phys.y;
+    int s_w = container->phys.w;
+    int s_h = container->phys.h;
+    int s_title_h = container->phys_title_height;
+    int s_resize_zone = container->phys_resize_zone;
 
     int mouse_x, mouse_y;
     input_get_mouse(&mouse_x, &mouse_y);
 
+    int old_x = container->x, old_y = container->y;
+    int old_w = container->w, old_h = container->h;
+
     bool in_title_bar = container->has_title_bar &&
         mouse_x >= s_x &&
         mouse_x <= s_x + s_w &&
@@ -197,45 +208,52 @@ void axUpdateContainer(axParent* container, axEvent* event) {
             }
             break;
     }
+
+    // Children move with the container and may be uncovered by it, so
+    // geometry changes repaint the whole window
+    if (!container->is_open || container->x != old_x || container->y != old_y ||
+        container->w != old_w || container->h != old_h) {
+        axInvalidateAll();
+    }
 }
 
-// registering stuffs
+void axFreeContainer(axParent* parent) {
+    if (!parent) return;
+    if (parent->is_window) {
+        free_parent(parent);
+    }
+}
 
-axParent* container_widgets[MAX_CONTAINERS];
-int containers_count = 0;
+/* ---------- registration ---------- */
+static void container_update(void* w, axEvent* ev) { axUpdateContainer((axParent*)w, ev); }
+static void container_render(void* w) { axRenderContainer((axParent*)w); }
+static void container_free(void* w) { axFreeContainer((axParent*)w); }
 
-void axRegisterContainer(axParent* container) {
-    if (containers_count < MAX_CONTAINERS) {
-        container_widgets[containers_count] = container;
-        containers_count++;
-    }
+static bool container_bounds(void* w, Rect* out) {
+    axParent* c = (axParent*)w;
+    if (!c->is_open) return false;
+    *out = *parent_clip_rect(c);
+    return true;
 }
 
-void axRenderAllRegisteredContainers(void) {
-    for (int i = 0; i < containers_count; i++) {
-        axRenderContainer(container_widgets[i]);
-    }
+// Containers paint under every widget, and dragging one moves its children
+const axWidgetClass container_class = {
+    "container", container_update, container_render, container_free, container_bounds, container_bounds,
+    AX_PHASE_UPDATE_CONTAINERS, AX_PHASE_RENDER_CONTAINERS, AX_Z_CONTAINERS, HIT_MOVES_LAYOUT
+};
+
+axWidgetHandle axRegisterContainer(axParent* container) {
+    return axRegisterWidget(container, &container_class);
 }
 
-void axUpdateAllRegisteredContainers(axEvent *event) {
-    for (int i = 0; i < containers_count; i++) {
-        axUpdateContainer(container_widgets[i], event);
-    }
+void axRenderAllRegisteredContainers(void) {
+    registry_render_class(&container_class);
 }
 
-void axFreeContainer(axParent* parent) {
-    if (!parent) return;
-    if (parent->is_window) {
-        free_parent(parent);
-    }
+void axUpdateAllRegisteredContainers(axEvent *event) {
+    registry_update_class(&container_class, event);
 }
 
 void axFreeAllRegisteredContainers(void) {
-    for (int i = 0; i < containers_count; i++) {
-        if (container_widgets[i]) {
-            axFreeContainer(container_widgets[i]);
-            container_widgets[i] = NULL;
-        }
-    }
-    containers_count = 0;
+    axFreeAllWidgets(&container_class);
 }
@@ -2,8 +2,10 @@
 #include "../../include/widgets/drop.h"
 #include "../../include/core/theme.h"
 #include "../../axo.h"
+#include "../../include/core/intern.h"
 #include "../../include/core/parent.h"   // for Rect
 
+#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -26,34 +28,245 @@ axDropDown axCreateDropDown(axParent* parent, int x, int y, int w, int h,
     d.options        = options;
     d.option_count   = option_count;
     d.selected_index = -1;
-    d.place_holder   = strdup("select option");
+    d.place_holder   = intern_string("select option");
     return d;
 }
 
 /* --------------------------------------------------------------------- */
-/* Setters – unchanged (just copy) */
+/* Setters */
+static void dropdown_invalidate(axDropDown* d);
+
 void axSetDropDownBgColor(axDropDown* d, Color c) {
     if (!d) return;
-    if (!d->custom_bg_color) d->custom_bg_color = malloc(sizeof(Color));
-    if (d->custom_bg_color) *d->custom_bg_color = c;
+    d->custom_bg_color = COLOR_OVERRIDE(c);
+    dropdown_invalidate(d);
 }
 void axSetDropDownButtonColor(axDropDown* d, Color c) {
     if (!d) return;
-    if (!d->custom_button_color) d->custom_button_color = malloc(sizeof(Color));
-    if (d->custom_button_color) *d->custom_button_color = c;
+    d->custom_button_color = COLOR_OVERRIDE(c);
+    dropdown_invalidate(d);
 }
 void axSetDropDownTextColor(axDropDown* d, Color c) {
     if (!d) return;
-    if (!d->custom_text_color) d->custom_text_color = malloc(sizeof(Color));
-    if (d->custom_text_color) *d->custom_text_color = c;
+    d->custom_text_color = COLOR_OVERRIDE(c);
+    dropdown_invalidate(d);
 }
 void axSetDropDownHighLightColor(axDropDown* d, Color c) {
     if (!d) return;
-    if (!d->custom_highlight_color) d->custom_highlight_color = malloc(sizeof(Color));
-    if (d->custom_highlight_color) *d->custom_highlight_color = c;
+    d->custom_highlight_color = COLOR_OVERRIDE(c);
+    dropdown_invalidate(d);
 }
 void axSetDropFontSize(axDropDown* d, int size) {
-    if (d) d->font_size = size;
+    if (!d) return;
+    d->font_size = size;
+    dropdown_invalidate(d);
+}
+void axSetDropDownMaxVisible(axDropDown* d, int rows) {
+    if (!d) return;
+    dropdown_invalidate(d);   // the old list height
+    d->max_visible = rows > 0 ? rows : 0;
+}
+
+/* --------------------------------------------------------------------- */
+/* Filter index */
+/* --------------------------------------------------------------------- */
+// Suffix array over the lowercased options. Every option containing the
+// filter owns a suffix starting with it, and those suffixes sit next to
+// each other, so a keystroke is two binary searches plus the hits.
+typedef struct {
+    int pos;      // offset into text
+    int option;   // option the suffix belongs to
+} Suffix;
+
+struct DropIndex {
+    char** options;         // array and count the index was built from
+    int    option_count;
+    char*  text;            // lowercased options, each NUL-terminated, back to back
+    Suffix* suffixes;       // every non-NUL offset of text, in suffix order
+    int    suffix_count;
+    int*   matches;         // options matching the filter, ascending
+    int    match_count;
+    int*   hits;            // scratch: owners of the matching suffixes
+};
+
+static const char* sort_text;   // qsort has no context argument
+
+static int compare_suffixes(const void* a, const void* b)
+{
+    return strcmp(sort_text + ((const Suffix*)a)->pos, sort_text + ((const Suffix*)b)->pos);
+}
+
+static int compare_ints(const void* a, const void* b)
+{
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static void free_index(DropIndex* ix)
+{
+    if (!ix) return;
+    free(ix->text);
+    free(ix->suffixes);
+    free(ix->matches);
+    free(ix->hits);
+    free(ix);
+}
+
+static DropIndex* build_index(char** options, int option_count)
+{
+    DropIndex* ix = calloc(1, sizeof(DropIndex));
+    if (!ix) return NULL;
+    ix->options = options;
+    ix->option_count = option_count;
+
+    size_t len = 0;
+    for (int i = 0; i < option_count; i++) len += (options[i] ? strlen(options[i]) : 0) + 1;
+    ix->text = malloc(len > 0 ? len : 1);
+    ix->suffixes = malloc(sizeof(Suffix) * (len > 0 ? len : 1));
+    ix->matches = malloc(sizeof(int) * (option_count > 0 ? option_count : 1));
+    ix->hits = malloc(sizeof(int) * (len > 0 ? len : 1));
+    if (!ix->text || !ix->suffixes || !ix->matches || !ix->hits) {
+        free_index(ix);
+        return NULL;
+    }
+
+    int pos = 0;
+    for (int i = 0; i < option_count; i++) {
+        for (const char* c = options[i] ? options[i] : ""; *c; c++) {
+            ix->suffixes[ix->suffix_count++] = (Suffix){ pos, i };
+            ix->text[pos++] = (char)tolower((unsigned char)*c);
+        }
+        ix->text[pos++] = '\0';
+    }
+    sort_text = ix->text;
+    qsort(ix->suffixes, ix->suffix_count, sizeof(Suffix), compare_suffixes);
+    return ix;
+}
+
+// First suffix whose first n bytes compare >= needle (or > needle if `past`)
+static int suffix_bound(const DropIndex* ix, const char* needle, int n, bool past)
+{
+    int lo = 0, hi = ix->suffix_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        int c = strncmp(ix->text + ix->suffixes[mid].pos, needle, n);
+        if (c < 0 || (past && c == 0)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static bool index_current(const axDropDown* d)
+{
+    return d->index && d->index->options == d->options && d->index->option_count == d->option_count;
+}
+
+// Recomputes the matches for the current filter and scrolls back to the top
+static void refilter(axDropDown* d)
+{
+    d->scroll = 0;
+    if (d->filter_len == 0) return;
+    if (!index_current(d)) {
+        if (d->index_failed) return;
+        free_index(d->index);
+        d->index = build_index(d->options, d->option_count);
+        if (!d->index) {
+            printf("Failed to build dropdown filter index, scanning instead\n");
+            d->index_failed = true;
+            return;
+        }
+    }
+
+    char needle[DROPDOWN_FILTER_MAX];
+    for (int i = 0; i <= d->filter_len; i++) needle[i] = (char)tolower((unsigned char)d->filter[i]);
+    DropIndex* ix = d->index;
+    int lo = suffix_bound(ix, needle, d->filter_len, false);
+    int hi = suffix_bound(ix, needle, d->filter_len, true);
+
+    // One hit per occurrence; an option containing the filter twice is listed once
+    for (int i = lo; i < hi; i++) ix->hits[i - lo] = ix->suffixes[i].option;
+    qsort(ix->hits, hi - lo, sizeof(int), compare_ints);
+    ix->match_count = 0;
+    for (int i = 0; i < hi - lo; i++) {
+        if (i == 0 || ix->hits[i] != ix->hits[i - 1]) ix->matches[ix->match_count++] = ix->hits[i];
+    }
+}
+
+// The index while a filter is active (NULL = no filter, or no index)
+static const DropIndex* active_filter(axDropDown* d)
+{
+    if (d->filter_len == 0) return NULL;
+    if (!index_current(d) && !d->index_failed) refilter(d);
+    return index_current(d) ? d->index : NULL;
+}
+
+// Fallback while the index cannot be built: case-insensitive substring test
+static bool option_matches(const axDropDown* d, int option)
+{
+    const char* s = d->options[option] ? d->options[option] : "";
+    for (; *s; s++) {
+        int n = 0;
+        while (n < d->filter_len && s[n] &&
+               tolower((unsigned char)s[n]) == tolower((unsigned char)d->filter[n])) n++;
+        if (n == d->filter_len) return true;
+    }
+    return false;
+}
+
+static bool scanning(const axDropDown* d)
+{
+    return d->filter_len > 0 && d->index_failed;
+}
+
+void axDropDownOptionsChanged(axDropDown* d)
+{
+    if (!d) return;
+    free_index(d->index);
+    d->index = NULL;
+    d->index_failed = false;
+    refilter(d);
+}
+
+/* ---------- list view ---------- */
+static int view_count(axDropDown* d)
+{
+    const DropIndex* ix = active_filter(d);
+    if (ix) return ix->match_count;
+    if (!scanning(d)) return d->option_count;
+    int n = 0;
+    for (int i = 0; i < d->option_count; i++) n += option_matches(d, i);
+    return n;
+}
+
+// Option shown on a row of the (filtered) list
+static int view_option(axDropDown* d, int row)
+{
+    const DropIndex* ix = active_filter(d);
+    if (ix) return ix->matches[row];
+    if (!scanning(d)) return row;
+    for (int i = 0; i < d->option_count; i++) {
+        if (option_matches(d, i) && row-- == 0) return i;
+    }
+    return 0;
+}
+
+static int max_rows(const axDropDown* d)
+{
+    return d->max_visible > 0 ? d->max_visible : DROPDOWN_MAX_VISIBLE;
+}
+
+// Rows the expanded list occupies right now
+static int visible_rows(axDropDown* d)
+{
+    int n = view_count(d);
+    return n < max_rows(d) ? n : max_rows(d);
+}
+
+static void clamp_scroll(axDropDown* d)
+{
+    int last = view_count(d) - visible_rows(d);
+    if (d->scroll > last) d->scroll = last;
+    if (d->scroll < 0) d->scroll = 0;
 }
 
 /* --------------------------------------------------------------------- */
@@ -77,47 +290,46 @@ void axRenderDropDown(axDropDown* d)
     float dpi  = base->dpi_scale;
 
     /* ---------- DPI-SCALED VALUES ---------- */
-    int abs_x = d->x + d->parent->x;
-    int abs_y = d->y + d->parent->y + d->parent->title_height;
-
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(d->w * dpi);
-    int sh = (int)roundf(d->h * dpi);
+    const Rect* g = widget_geom(&d->geom, d->parent, d->x, d->y, d->w, d->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
     int pad = (int)roundf(current_theme->padding * dpi);
     int font_sz = (int)roundf((d->font_size > 0 ? d->font_size : current_theme->default_font_size) * dpi);
 
-    /* ---------- PARENT CLIPPING (for containers) ---------- */
-    if (!d->parent->is_window) {
-        Rect pr = get_parent_rect(d->parent);           // our own Rect
-        pr.x = (int)roundf(pr.x * dpi);
-        pr.y = (int)roundf(pr.y * dpi);
-        pr.w = (int)roundf(pr.w * dpi);
-        pr.h = (int)roundf(pr.h * dpi);
-        clip_begin(base, &pr);
-    } else {
-        clip_begin(base, NULL);  // no clipping for root window
+    /* ---------- PARENT CLIPPING + CULLING ---------- */
+    clip_begin(base, parent_clip_rect(d->parent));
+    // The visible rows of the list hang below the button while expanded
+    int rows = d->is_expanded ? visible_rows(d) : 0;
+    Rect extent = { sx, sy, sw, sh * (rows + 1) };
+    if (!clip_visible(base, &extent)) {
+        clip_end(base);
+        return;
     }
 
     /* ---------- COLORS ---------- */
-    Color button = d->custom_button_color ? *d->custom_button_color : current_theme->button_normal;
+    Color button = color_or(d->custom_button_color, current_theme->button_normal);
     if (d->is_hovered) {
-        button = d->custom_button_color ? lighten_color(*d->custom_button_color, 0.1f)
-                                        : current_theme->button_hovered;
+        button = d->custom_button_color.set ? lighten_color(d->custom_button_color.color, 0.1f)
+                                            : current_theme->button_hovered;
     }
-    Color bg        = d->custom_bg_color        ? *d->custom_bg_color        : current_theme->bg_secondary;
-    Color text      = d->custom_text_color      ? *d->custom_text_color      : current_theme->text_primary;
-    Color highlight = d->custom_highlight_color ? *d->custom_highlight_color : current_theme->accent;
+    Color bg        = color_or(d->custom_bg_color, current_theme->bg_secondary);
+    Color text      = color_or(d->custom_text_color, current_theme->text_primary);
+    Color highlight = color_or(d->custom_highlight_color, current_theme->accent);
 
     /* ---------- MAIN BUTTON ---------- */
     draw_rect(base, sx, sy, sw, sh, button);
 
-    /* ---------- TEXT (placeholder or selected) ---------- */
+    /* ---------- TEXT (filter, selected or placeholder) ---------- */
     const char* display = (d->selected_index >= 0 && d->selected_index < d->option_count)
                           ? d->options[d->selected_index]
                           : d->place_holder;
+    if (d->is_expanded && d->filter_len > 0) display = d->filter;
     int text_y = sy + (sh - font_sz) / 2;
-    draw_text_from_font(base, global_font, display, sx + pad, text_y, text, ALIGN_LEFT);
+    if (display && display[0]) {
+        draw_text_from_font(base, global_font, display, sx + pad, text_y, text, ALIGN_LEFT);
+    }
 
     /* ---------- ARROW (down/up) ---------- */
     int arrow_size = (int)roundf((d->h / 3.0f) * dpi);
@@ -135,18 +347,32 @@ void axRenderDropDown(axDropDown* d)
         draw_upside_down_triangle(base, arrow_x, arrow_y, arrow_size, text);
     }
 
-    /* ---------- EXPANDED OPTIONS ---------- */
+    /* ---------- EXPANDED OPTIONS (visible rows only) ---------- */
     if (d->is_expanded) {
-        for (int i = 0; i < d->option_count; ++i) {
-            int oy_logical = abs_y + d->h * (i + 1);
-            int oy = (int)roundf(oy_logical * dpi);
+        clamp_scroll(d);
+        for (int row = 0; row < rows; ++row) {
+            int i  = view_option(d, d->scroll + row);
+            int oy = sy + sh * (row + 1);
 
             Color opt_bg = (i == d->selected_index) ? highlight : bg;
             draw_rect(base, sx, oy, sw, sh, opt_bg);
 
-            int opt_text_y = oy + (sh - font_sz) / 2;
-            draw_text_from_font(base, global_font, d->options[i],
-                                sx + pad, opt_text_y, text, ALIGN_LEFT);
+            if (d->options[i] && d->options[i][0]) {
+                int opt_text_y = oy + (sh - font_sz) / 2;
+                draw_text_from_font(base, global_font, d->options[i],
+                                    sx + pad, opt_text_y, text, ALIGN_LEFT);
+            }
+        }
+
+        // Scroll thumb along the right edge when the list does not fit
+        int count = view_count(d);
+        if (count > rows && rows > 0) {
+            int track_h = sh * rows;
+            int thumb_w = (int)roundf(4 * dpi);
+            int thumb_h = track_h * rows / count;
+            if (thumb_h < sh / 2) thumb_h = sh / 2;
+            int thumb_y = sy + sh + (track_h - thumb_h) * d->scroll / (count - rows);
+            draw_rect(base, sx + sw - thumb_w, thumb_y, thumb_w, thumb_h, highlight);
         }
     }
 
@@ -155,19 +381,72 @@ void axRenderDropDown(axDropDown* d)
 }
 
 /* --------------------------------------------------------------------- */
-void axUpdateDropDown(axDropDown* d, axEvent* ev)
+static void open_list(axDropDown* d)
 {
-    if (!d || !d->parent || !d->parent->is_open) return;
+    d->is_expanded = true;
+    d->filter[0] = '\0';
+    d->filter_len = 0;
+    // Start with the selection in view
+    d->scroll = d->selected_index - max_rows(d) / 2;
+    clamp_scroll(d);
+}
+
+static void close_list(axDropDown* d)
+{
+    d->is_expanded = false;
+    d->filter[0] = '\0';
+    d->filter_len = 0;
+}
+
+// Type-ahead while the list is open
+static void update_dropdown_keys(axDropDown* d, axEvent* ev)
+{
+    if (ev->type == EVENT_TEXTINPUT) {
+        int n = (int)strlen(ev->text.text);
+        if (n == 0 || d->filter_len + n >= DROPDOWN_FILTER_MAX) return;
+        memcpy(d->filter + d->filter_len, ev->text.text, n + 1);
+        d->filter_len += n;
+        refilter(d);
+        return;
+    }
+    if (ev->type != EVENT_KEYDOWN) return;
 
-    float dpi = d->parent->base.dpi_scale;
+    switch (ev->key.key) {
+        case KEY_BACKSPACE:
+            if (d->filter_len == 0) return;
+            // Drop one whole UTF-8 character
+            do { d->filter_len--; } while (d->filter_len > 0 && ((unsigned char)d->filter[d->filter_len] & 0xC0) == 0x80);
+            d->filter[d->filter_len] = '\0';
+            refilter(d);
+            break;
+        case KEY_RETURN:
+            if (view_count(d) > 0) d->selected_index = view_option(d, d->scroll);
+            close_list(d);
+            break;
+        case KEY_ESCAPE:
+            close_list(d);
+            break;
+        case KEY_UP:
+            d->scroll--;
+            clamp_scroll(d);
+            break;
+        case KEY_DOWN:
+            d->scroll++;
+            clamp_scroll(d);
+            break;
+        default:
+            break;
+    }
+}
 
+static void update_dropdown_state(axDropDown* d, axEvent* ev)
+{
     /* ---------- DPI-SCALED ABSOLUTE POSITION ---------- */
-    int abs_x = d->x + d->parent->x;
-    int abs_y = d->y + d->parent->y + d->parent->title_height;
-    int sx    = (int)roundf(abs_x * dpi);
-    int sy    = (int)roundf(abs_y * dpi);
-    int sw    = (int)roundf(d->w  * dpi);
-    int sh    = (int)roundf(d->h  * dpi);
+    const Rect* g = widget_geom(&d->geom, d->parent, d->x, d->y, d->w, d->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
 
     /* ---------- HOVER (mouse in physical pixels) ---------- */
     int mouse_x, mouse_y;
@@ -175,6 +454,16 @@ void axUpdateDropDown(axDropDown* d, axEvent* ev)
     d->is_hovered = (mouse_x >= sx && mouse_x <= sx + sw &&
                      mouse_y >= sy && mouse_y <= sy + sh);
 
+    if (d->is_expanded) {
+        /* ---------- SCROLL / TYPE-AHEAD ---------- */
+        if (ev->type == EVENT_MOUSEWHEEL) {
+            d->scroll -= ev->mouseWheel.dy * DROPDOWN_WHEEL_ROWS;
+            clamp_scroll(d);
+            return;
+        }
+        update_dropdown_keys(d, ev);
+    }
+
     /* ---------- CLICK ---------- */
     if (ev->type != EVENT_MOUSEBUTTONDOWN || ev->mouseButton.button != MOUSE_LEFT) return;
 
@@ -183,66 +472,95 @@ void axUpdateDropDown(axDropDown* d, axEvent* ev)
 
     // Click on main button → toggle
     if (mx >= sx && mx <= sx + sw && my >= sy && my <= sy + sh) {
-        d->is_expanded = !d->is_expanded;
+        if (d->is_expanded) close_list(d);
+        else open_list(d);
         return;
     }
 
-    // Click on option
+    // Click on a visible row picks it; anywhere else closes the list
     if (d->is_expanded) {
-        bool clicked_option = false;
-        for (int i = 0; i < d->option_count; ++i) {
-            int oy = (int)roundf((abs_y + d->h * (i + 1)) * dpi);
-            if (mx >= sx && mx <= sx + sw && my >= oy && my <= oy + sh) {
-                d->selected_index = i;
-                d->is_expanded = false;
-                clicked_option = true;
-                break;
-            }
-        }
-        // Click outside → close
-        if (!clicked_option) {
-            d->is_expanded = false;
+        int row = sh > 0 ? (my - sy - sh) / sh : -1;
+        if (mx >= sx && mx <= sx + sw && my > sy + sh && row < visible_rows(d)) {
+            d->selected_index = view_option(d, d->scroll + row);
         }
+        close_list(d);
+    }
+}
+
+// Covers the longest the list can get, whether it just opened, closed or
+// shrank under a filter
+static void dropdown_invalidate(axDropDown* d)
+{
+    if (!d->parent || axGetRedrawMode() != AX_REDRAW_ON_DEMAND) return;
+    const Rect* g = widget_geom(&d->geom, d->parent, d->x, d->y, d->w, d->h);
+    axInvalidateRect((Rect){ g->x, g->y, g->w, g->h * (max_rows(d) + 1) });
+}
+
+void axUpdateDropDown(axDropDown* d, axEvent* ev)
+{
+    if (!d || !d->parent || !d->parent->is_open) return;
+
+    bool was_hovered  = d->is_hovered;
+    bool was_expanded = d->is_expanded;
+    int  old_selected = d->selected_index;
+    int  old_scroll   = d->scroll;
+    int  old_filter   = d->filter_len;
+
+    update_dropdown_state(d, ev);
+
+    if (d->is_hovered != was_hovered || d->is_expanded != was_expanded ||
+        d->selected_index != old_selected || d->scroll != old_scroll ||
+        d->filter_len != old_filter) {
+        dropdown_invalidate(d);
     }
 }
 
 /* --------------------------------------------------------------------- */
 void axFreeDropDown(axDropDown* d)
 {
+    // placeholder is interned and colors are inline: only the index is owned
     if (!d) return;
-    free(d->place_holder);
-    free(d->custom_bg_color);
-    free(d->custom_button_color);
-    free(d->custom_text_color);
-    free(d->custom_highlight_color);
+    free_index(d->index);
+    d->index = NULL;
+    d->index_failed = false;
 }
 
 /* --------------------------------------------------------------------- */
-/* Global registration (unchanged) */
-axDropDown* drop_widgets[MAX_DROPS];
-int   drops_count = 0;
+/* Registration */
+/* --------------------------------------------------------------------- */
+static void dropdown_update(void* w, axEvent* ev) { axUpdateDropDown((axDropDown*)w, ev); }
+static void dropdown_render(void* w) { axRenderDropDown((axDropDown*)w); }
+static void dropdown_free(void* w) { axFreeDropDown((axDropDown*)w); }
 
-void axRegisterDropDown(axDropDown* d)
+static bool dropdown_bounds(void* w, Rect* out)
 {
-    if (drops_count < MAX_DROPS) drop_widgets[drops_count++] = d;
+    axDropDown* d = (axDropDown*)w;
+    if (!d->parent || !d->parent->is_open) return false;
+    // The visible rows of the list hang below the button while it is open
+    Rect r = *widget_geom(&d->geom, d->parent, d->x, d->y, d->w, d->h);
+    if (d->is_expanded) r.h *= visible_rows(d) + 1;
+    *out = clip_to_parent(d->parent, &r) ? r : (Rect){ 0, 0, 0, 0 };
+    return true;
+}
+
+const axWidgetClass dropdown_class = {
+    "dropdown", dropdown_update, dropdown_render, dropdown_free, dropdown_bounds, dropdown_bounds,
+    AX_PHASE_UPDATE_DROPDOWNS, AX_PHASE_RENDER_DROPDOWNS, AX_Z_WIDGETS, 0
+};
+
+axWidgetHandle axRegisterDropDown(axDropDown* d)
+{
+    return axRegisterWidget(d, &dropdown_class);
 }
 void axRenderAllRegisteredDropDown(void)
 {
-    for (int i = 0; i < drops_count; ++i)
-        if (drop_widgets[i]) axRenderDropDown(drop_widgets[i]);
+    registry_render_class(&dropdown_class);
 }
 void axUpdateAllRegisteredDropDown(axEvent* ev)
 {
-    for (int i = 0; i < drops_count; ++i)
-        if (drop_widgets[i]) axUpdateDropDown(drop_widgets[i], ev);
+    registry_update_class(&dropdown_class, ev);
 }
 void axFreeAllRegisteredDropDown(void)
 {
-    for (int i = 0; i < drops_count; ++i) {
-        if (drop_widgets[i]) {
-            axFreeDropDown(drop_widgets[i]);
-            drop_widgets[i] = NULL;
-        }
-    }
-    drops_count = 0;
+    axFreeAllWidgets(&dropdown_class);
 }
@@ -2,6 +2,7 @@
 #include "../../include/widgets/entry.h"
 #include "../../include/core/theme.h"
 #include "../../axo.h"
+#include "../../include/core/intern.h"
 #include "../../include/core/parent.h"   // for Rect
 
 #include <stdlib.h>
@@ -9,12 +10,25 @@
 #include <math.h>
 
 /* --------------------------------------------------------------------- */
-/* Helper: measure a UTF-8 substring with the *global* font */
+/* Helper: caret x of every byte of txt[0, len) with the *global* font   */
+/* (len + 1 entries; shared buffer, valid until the next call)           */
 /* --------------------------------------------------------------------- */
-static int measure_utf8(const char* txt, int* w, int* h)
+static int* offsets = NULL;   /* freed with any entry, regrown on demand */
+static int  offsets_cap = 0;
+
+static const int* measure_offsets(const char* txt, int len)
 {
-    if (!global_font) return -1;
-    return ttf_size_utf8(global_font, txt, w, h);
+    if (!global_font) return NULL;
+    if (len + 1 > offsets_cap) {
+        int new_cap = offsets_cap ? offsets_cap : 256;
+        while (new_cap < len + 1) new_cap *= 2;
+        int* grown = realloc(offsets, sizeof(int) * new_cap);
+        if (!grown) return NULL;
+        offsets = grown;
+        offsets_cap = new_cap;
+    }
+    ttf_measure_prefix_widths_n(global_font, txt, len, offsets);
+    return offsets;
 }
 
 /* --------------------------------------------------------------------- */
@@ -32,12 +46,13 @@ axEntry axCreateEntry(axParent* parent, int x, int y, int w, int max_length)
 
     axEntry e = {0};
     e.parent       = parent;
-    e.place_holder = strdup(" ");
+    e.place_holder = intern_string(" ");
     e.x = x;  e.y = y;  e.w = w;
     e.h = logical_font_size + 2 * logical_padding;
     e.max_length = max_length;
-    e.text = malloc(max_length + 1);
-    if (e.text) e.text[0] = '\0';
+    if (!text_buffer_init(&e.text, max_length)) {
+        printf("Failed to allocate memory for entry text\n");
+    }
     return e;
 }
 
@@ -45,8 +60,39 @@ axEntry axCreateEntry(axParent* parent, int x, int y, int w, int max_length)
 void axSetEntryPlaceHolder(axEntry* e, const char* placeholder)
 {
     if (!e) return;
-    free(e->place_holder);
-    e->place_holder = placeholder ? strdup(placeholder) : strdup(" ");
+    e->place_holder = intern_string(placeholder ? placeholder : " ");
+}
+
+/* --------------------------------------------------------------------- */
+const char* axEntryGetText(axEntry* e)
+{
+    return e ? text_buffer_cstr(&e->text) : "";
+}
+
+void axEntrySetText(axEntry* e, const char* text)
+{
+    if (!e) return;
+    text_buffer_set(&e->text, text);
+    e->cursor_pos = e->text.length;
+    e->selection_start = -1;
+    e->visible_text_start = 0;
+    update_visible_text(e);
+    if (e->parent) axInvalidateWidget(e->parent, e->x, e->y, e->w, e->h);
+}
+
+/* --------------------------------------------------------------------- */
+/* Replaces the selection (if any) with s[0, n) and moves the caret past it */
+/* --------------------------------------------------------------------- */
+static void entry_replace_selection(axEntry* e, const char* s, int n)
+{
+    int start = e->cursor_pos, end = e->cursor_pos;
+    if (e->selection_start != -1) {
+        start = (e->selection_start < e->cursor_pos) ? e->selection_start : e->cursor_pos;
+        end   = (e->selection_start < e->cursor_pos) ? e->cursor_pos : e->selection_start;
+    }
+    if (!text_buffer_replace(&e->text, start, end - start, s, n)) return;   // over max_length
+    e->cursor_pos = start + n;
+    e->selection_start = -1;
 }
 
 /* --------------------------------------------------------------------- */
@@ -58,25 +104,12 @@ void axRenderEntry(axEntry* e)
 
     float dpi = e->parent->base.dpi_scale;
 
-    /* ---------- PARENT CLIP (if any) ---------- */
-    Rect parent_clip = {0,0,0,0};
-    bool has_parent_clip = false;
-    if (!e->parent->is_window) {
-        parent_clip = get_parent_rect(e->parent);
-        parent_clip.x = (int)roundf(parent_clip.x * dpi);
-        parent_clip.y = (int)roundf(parent_clip.y * dpi);
-        parent_clip.w = (int)roundf(parent_clip.w * dpi);
-        parent_clip.h = (int)roundf(parent_clip.h * dpi);
-        has_parent_clip = SDL_TRUE;
-    }
-
     /* ---------- PHYSICAL BOUNDS ---------- */
-    int abs_x = e->x + e->parent->x;
-    int abs_y = e->y + e->parent->y + e->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(e->w * dpi);
-    int sh = (int)roundf(e->h * dpi);
+    const Rect* g = widget_geom(&e->geom, e->parent, e->x, e->y, e->w, e->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
     int border = (int)roundf(2 * dpi);
     int pad    = (int)roundf(current_theme->padding * dpi);
 
@@ -84,9 +117,12 @@ void axRenderEntry(axEntry* e)
 
     int font_h = ttf_font_height(global_font);   /* wrapper for TTF_FontHeight */
 
-    Rect parent_r = { parent_clip.x, parent_clip.y, parent_clip.w, parent_clip.h };
-    if (has_parent_clip) {
-        clip_begin(&e->parent->base, &parent_r);
+    /* ---------- PARENT CLIP + CULLING ---------- */
+    clip_begin(&e->parent->base, parent_clip_rect(e->parent));
+    Rect extent = { sx, sy, sw, sh };
+    if (!clip_visible(&e->parent->base, &extent)) {
+        clip_end(&e->parent->base);
+        return;
     }
 
     /* ---------- BACKGROUND / BORDER ---------- */
@@ -96,34 +132,22 @@ void axRenderEntry(axEntry* e)
               sw - 2*border, sh - 2*border,
               current_theme->bg_secondary);
 
-    if (has_parent_clip) {
-        clip_end(&e->parent->base);
-    }
-
-    /* ---------- TEXT CLIP – now includes the padding area ---------- */
+    /* ---------- TEXT CLIP – now includes the padding area (nested in the parent clip) ---------- */
     Rect text_clip = {
         sx + border,               /* left   = border */
         sy + border,               /* top    = border */
         sw - 2*border,             /* width  = full inner width  */
         sh - 2*border              /* height = full inner height */
     };
-    Rect effective_text;
-    if (has_parent_clip) {
-        if (!rect_intersect(&parent_clip, &text_clip, &effective_text))
-            return;
-    } else {
-        effective_text = text_clip;
-    }
-    if (effective_text.w <= 0 || effective_text.h <= 0) return;
-    Rect text_r = { effective_text.x, effective_text.y, effective_text.w, effective_text.h };
-    clip_begin(&e->parent->base, &text_r);
+    clip_begin(&e->parent->base, &text_clip);
 
     /* ---------- TEXT DRAWING AREA (inside padding) ---------- */
     int text_x = sx + border + pad;
     int text_y = sy + (sh - font_h) / 2;               /* vertical centre */
 
-    const char* display = (e->is_active || e->text[0])
-                          ? e->text + e->visible_text_start
+    /* single line: flattening is one gap move, and a no-op while typing at the end */
+    const char* display = (e->is_active || e->text.length)
+                          ? text_buffer_cstr(&e->text) + e->visible_text_start
                           : e->place_holder;
     Color txt_col = (display == e->place_holder) ? current_theme->text_secondary
                                                  : current_theme->text_primary;
@@ -136,23 +160,13 @@ void axRenderEntry(axEntry* e)
                         - e->visible_text_start;
 
         if (sel_start < 0) sel_start = 0;
-        if (sel_end   > (int)strlen(display)) sel_end = (int)strlen(display);
-        if (sel_start < sel_end) {
-            char tmp[256];
-            int offset = 0, w = 0;
-
-            /* left part */
-            strncpy(tmp, display, sel_start); tmp[sel_start] = '\0';
-            measure_utf8(tmp, &offset, NULL);
-
-            /* selected part */
-            strncpy(tmp, display + sel_start, sel_end - sel_start);
-            tmp[sel_end - sel_start] = '\0';
-            measure_utf8(tmp, &w, NULL);
-
+        int display_len = e->text.length - e->visible_text_start;
+        if (sel_end   > display_len) sel_end = display_len;
+        const int* off = measure_offsets(display, sel_end);
+        if (sel_start < sel_end && off) {
             draw_rect(&e->parent->base,
-                      text_x + offset, text_y,
-                      w, font_h,
+                      text_x + off[sel_start], text_y,
+                      off[sel_end] - off[sel_start], font_h,
                       current_theme->accent_hovered);
         }
     }
@@ -166,11 +180,10 @@ void axRenderEntry(axEntry* e)
     /* ---------- CURSOR ---------- */
     if (e->is_active) {
         int cur_off = 0;
-        if (e->cursor_pos - e->visible_text_start > 0) {
-            char tmp[256];
-            int len = e->cursor_pos - e->visible_text_start;
-            strncpy(tmp, display, len); tmp[len] = '\0';
-            measure_utf8(tmp, &cur_off, NULL);
+        int len = e->cursor_pos - e->visible_text_start;
+        if (len > 0) {
+            const int* off = measure_offsets(display, len);
+            if (off) cur_off = off[len];
         }
         int cur_w = (int)roundf(2 * dpi);
         draw_rect(&e->parent->base,
@@ -179,7 +192,8 @@ void axRenderEntry(axEntry* e)
                   current_theme->accent);
     }
 
-    clip_end(&e->parent->base);
+    clip_end(&e->parent->base);   /* text clip */
+    clip_end(&e->parent->base);   /* parent clip */
 }
 
 /* --------------------------------------------------------------------- */
@@ -193,34 +207,23 @@ void update_visible_text(axEntry* e)
     int logical_padding = current_theme->padding;
     int max_vis_w = e->w - 2 * logical_padding;   /* logical pixels */
 
+    /* ---- caret x of every character, measured once ---- */
+    const char* txt = text_buffer_cstr(&e->text);
+    int txt_len = e->text.length;
+    const int* off = measure_offsets(txt, txt_len);
+    if (!off) return;
+
     /* ---- how many characters fit in the visible area? ---- */
-    int fit_w = 0, fit_chars = 0;
-    const char* txt = e->text;
-    for (int i = 0; i < (int)strlen(txt); ++i) {
-        char ch[2] = { txt[i], '\0' };
-        int cw = 0;
-        if (measure_utf8(ch, &cw, NULL) != 0) break;
-        if (fit_w + cw > max_vis_w) break;
-        fit_w += cw;
-        ++fit_chars;
-    }
+    int fit_chars = 0;
+    while (fit_chars < txt_len && off[fit_chars + 1] <= max_vis_w) ++fit_chars;
 
     /* ---- cursor pixel position (logical) ---- */
-    int cursor_px = 0;
-    if (e->cursor_pos > 0) {
-        char tmp[256];
-        int len = e->cursor_pos;
-        strncpy(tmp, txt, len); tmp[len] = '\0';
-        measure_utf8(tmp, &cursor_px, NULL);
-    }
+    int cursor_px = off[e->cursor_pos];
 
     /* ---- scroll right ---- */
     if (cursor_px > max_vis_w) {
-        while (cursor_px > max_vis_w && e->visible_text_start < (int)strlen(txt)) {
-            char ch[2] = { txt[e->visible_text_start], '\0' };
-            int cw = 0;
-            measure_utf8(ch, &cw, NULL);
-            cursor_px -= cw;
+        while (cursor_px > max_vis_w && e->visible_text_start < txt_len) {
+            cursor_px -= off[e->visible_text_start + 1] - off[e->visible_text_start];
             ++e->visible_text_start;
         }
     }
@@ -238,7 +241,7 @@ void update_visible_text(axEntry* e)
     }
 
     /* ---- clamp ---- */
-    int max_start = (int)strlen(txt) - fit_chars;
+    int max_start = txt_len - fit_chars;
     if (max_start < 0) max_start = 0;
     if (e->visible_text_start > max_start) e->visible_text_start = max_start;
 }
@@ -253,12 +256,20 @@ void axUpdateEntry(axEntry* e, axEvent* ev)
     float dpi = e->parent->base.dpi_scale;
     Uint16 mod = SDL_GetModState();
 
+    // Snapshot of everything the render depends on, for damage tracking
+    int was_active   = e->is_active;
+    int old_cursor   = e->cursor_pos;
+    int old_sel      = e->selection_start;
+    int old_visible  = e->visible_text_start;
+    bool maybe_edit  = e->is_active &&
+                       (ev->type == EVENT_KEYDOWN || ev->type == EVENT_TEXTINPUT);
+
     int abs_x = e->x + e->parent->x;
-    int abs_y = e->y + e->parent->y + e->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(e->w * dpi);
-    int sh = (int)roundf(e->h * dpi);
+    const Rect* g = widget_geom(&e->geom, e->parent, e->x, e->y, e->w, e->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
     int pad = (int)roundf(current_theme->padding * dpi);
 
     /* ---------- MOUSE DOWN ---------- */
@@ -269,19 +280,14 @@ void axUpdateEntry(axEntry* e, axEvent* ev)
             e->is_active = 1;
             e->is_mouse_selecting = 1;
             e->selection_start = -1;
+            text_buffer_break_undo(&e->text);
 
             int logical_mx = (int)roundf(mx / dpi);
             int click_off  = logical_mx - (abs_x + current_theme->padding);
-            int cum = 0, pos = 0;
-            for (int i = 0; i < (int)strlen(e->text); ++i) {
-                char ch[2] = { e->text[i], '\0' };
-                int cw = 0;
-                measure_utf8(ch, &cw, NULL);
-                if (cum + cw/2 > click_off) break;
-                cum += cw;
-                pos = i+1;
-            }
-            e->cursor_pos = pos;
+            int len = e->text.length;
+            const char* txt = text_buffer_cstr(&e->text);
+            const int* off = measure_offsets(txt, len);
+            e->cursor_pos = off ? ttf_caret_at_x(txt, off, len, click_off) : 0;
             update_visible_text(e);
         } else {
             e->is_active = 0;
@@ -303,68 +309,37 @@ void axUpdateEntry(axEntry* e, axEvent* ev)
 
             int logical_mx = (int)roundf(mx / dpi);
             int click_off  = logical_mx - (abs_x + current_theme->padding);
-            int cum = 0, pos = 0;
-            for (int i = 0; i < (int)strlen(e->text); ++i) {
-                char ch[2] = { e->text[i], '\0' };
-                int cw = 0;
-                measure_utf8(ch, &cw, NULL);
-                if (cum + cw/2 > click_off) break;
-                cum += cw;
-                pos = i+1;
-            }
-            e->cursor_pos = pos;
+            int len = e->text.length;
+            const char* txt = text_buffer_cstr(&e->text);
+            const int* off = measure_offsets(txt, len);
+            e->cursor_pos = off ? ttf_caret_at_x(txt, off, len, click_off) : 0;
             update_visible_text(e);
         }
     }
     /* ---------- TEXT INPUT ---------- */
     else if (ev->type == EVENT_TEXTINPUT && e->is_active) {
-        if (e->selection_start != -1) {
-            int start = (e->selection_start < e->cursor_pos) ? e->selection_start : e->cursor_pos;
-            int end   = (e->selection_start < e->cursor_pos) ? e->cursor_pos : e->selection_start;
-            memmove(e->text + start, e->text + end, strlen(e->text) - end + 1);
-            e->cursor_pos = start;
-            e->selection_start = -1;
-        }
-        int len = strlen(e->text);
-        int add = strlen(ev->text.text);
-        if (len + add < e->max_length) {
-            memmove(e->text + e->cursor_pos + add,
-                    e->text + e->cursor_pos,
-                    len - e->cursor_pos + 1);
-            memcpy(e->text + e->cursor_pos, ev->text.text, add);
-            e->cursor_pos += add;
-            update_visible_text(e);
-        }
+        entry_replace_selection(e, ev->text.text, (int)strlen(ev->text.text));
+        update_visible_text(e);
     }
     /* ---------- KEYBOARD ---------- */
     else if (ev->type == EVENT_KEYDOWN && e->is_active) {
-        #define DEL_SEL() do { \
-            int s = (e->selection_start < e->cursor_pos) ? e->selection_start : e->cursor_pos; \
-            int d = (e->selection_start < e->cursor_pos) ? e->cursor_pos : e->selection_start; \
-            memmove(e->text + s, e->text + d, strlen(e->text) - d + 1); \
-            e->cursor_pos = s; e->selection_start = -1; \
-        } while(0)
-
         if (ev->key.key == KEY_BACKSPACE) {
-            if (e->selection_start != -1) { DEL_SEL(); }
-            else if (e->cursor_pos > 0) {
-                memmove(e->text + e->cursor_pos - 1,
-                        e->text + e->cursor_pos,
-                        strlen(e->text) - e->cursor_pos + 1);
+            if (e->selection_start != -1) { entry_replace_selection(e, NULL, 0); }
+            else if (e->cursor_pos > 0 &&
+                     text_buffer_replace(&e->text, e->cursor_pos - 1, 1, NULL, 0)) {
                 --e->cursor_pos;
             }
             update_visible_text(e);
         }
         else if (ev->key.key == KEY_DELETE) {
-            if (e->selection_start != -1) { DEL_SEL(); }
-            else if (e->cursor_pos < (int)strlen(e->text)) {
-                memmove(e->text + e->cursor_pos,
-                        e->text + e->cursor_pos + 1,
-                        strlen(e->text) - e->cursor_pos);
+            if (e->selection_start != -1) { entry_replace_selection(e, NULL, 0); }
+            else if (e->cursor_pos < e->text.length) {
+                text_buffer_replace(&e->text, e->cursor_pos, 1, NULL, 0);
             }
             update_visible_text(e);
         }
         else if (ev->key.key == KEY_LEFT) {
+            text_buffer_break_undo(&e->text);
             if (e->cursor_pos > 0) {
                 if (mod & KMOD_SHIFT) {
                     if (e->selection_start == -1) e->selection_start = e->cursor_pos;
@@ -377,7 +352,8 @@ void axUpdateEntry(axEntry* e, axEvent* ev)
             }
         }
         else if (ev->key.key == KEY_RIGHT) {
-            if (e->cursor_pos < (int)strlen(e->text)) {
+            text_buffer_break_undo(&e->text);
+            if (e->cursor_pos < e->text.length) {
                 if (mod & KMOD_SHIFT) {
                     if (e->selection_start == -1) e->selection_start = e->cursor_pos;
                     ++e->cursor_pos;
@@ -393,57 +369,54 @@ void axUpdateEntry(axEntry* e, axEvent* ev)
             e->selection_start = -1;
         }
         else if (ev->key.key == KEY_A && (ev->key.mod & KEY_MOD_CTRL)) {
-            if (e->text[0]) {
+            if (e->text.length) {
                 e->selection_start = 0;
-                e->cursor_pos = (int)strlen(e->text);
+                e->cursor_pos = e->text.length;
             }
         }
-        else if (ev->key.key == KEY_C && (ev->key.mod & KEY_MOD_CTRL)) {
-            if (e->selection_start != -1) {
-                int s   = (e->selection_start < e->cursor_pos) ? e->selection_start : e->cursor_pos;
-                int len = abs(e->cursor_pos - e->selection_start);
-                char* sel = malloc(len + 1);
-                if (sel) {
-                    strncpy(sel, e->text + s, len); sel[len] = '\0';
-                    clipboard_set_text(sel);
-                    free(sel);
-                }
+        /* Ctrl+Z undo, Ctrl+Y / Ctrl+Shift+Z redo */
+        else if ((ev->key.key == KEY_Z || ev->key.key == KEY_Y) && (ev->key.mod & KEY_MOD_CTRL)) {
+            bool redo = ev->key.key == KEY_Y || (ev->key.mod & KEY_MOD_SHIFT);
+            TextChange change;
+            if (redo ? text_buffer_redo(&e->text, &change) : text_buffer_undo(&e->text, &change)) {
+                e->cursor_pos = change.cursor;
+                e->selection_start = -1;
+                update_visible_text(e);
             }
         }
-        else if (ev->key.key == KEY_X && (ev->key.mod & KEY_MOD_CTRL)) {
+        else if ((ev->key.key == KEY_C || ev->key.key == KEY_X) && (ev->key.mod & KEY_MOD_CTRL)) {
             if (e->selection_start != -1) {
                 int s   = (e->selection_start < e->cursor_pos) ? e->selection_start : e->cursor_pos;
                 int len = abs(e->cursor_pos - e->selection_start);
                 char* sel = malloc(len + 1);
                 if (sel) {
-                    strncpy(sel, e->text + s, len); sel[len] = '\0';
+                    text_buffer_copy(&e->text, s, len, sel);
                     clipboard_set_text(sel);
                     free(sel);
                 }
-                DEL_SEL();
-                update_visible_text(e);
+                if (ev->key.key == KEY_X) {
+                    entry_replace_selection(e, NULL, 0);
+                    update_visible_text(e);
+                }
             }
         }
         else if (ev->key.key == KEY_V && (ev->key.mod & KEY_MOD_CTRL)) {
             if (clipboard_has_text()) {
                 char* paste = clipboard_get_text();
                 if (paste) {
-                    int plen = strlen(paste);
-                    int len  = strlen(e->text);
-                    if (e->selection_start != -1) { DEL_SEL(); len = strlen(e->text); }
-                    if (len + plen < e->max_length) {
-                        memmove(e->text + e->cursor_pos + plen,
-                                e->text + e->cursor_pos,
-                                len - e->cursor_pos + 1);
-                        memcpy(e->text + e->cursor_pos, paste, plen);
-                        e->cursor_pos += plen;
-                        update_visible_text(e);
-                    }
+                    text_buffer_break_undo(&e->text);   // a paste is its own undo step
+                    entry_replace_selection(e, paste, (int)strlen(paste));
+                    text_buffer_break_undo(&e->text);
+                    update_visible_text(e);
                     clipboard_free(paste);
                 }
             }
         }
-        #undef DEL_SEL
+    }
+
+    if (maybe_edit || e->is_active != was_active || e->cursor_pos != old_cursor ||
+        e->selection_start != old_sel || e->visible_text_start != old_visible) {
+        axInvalidateWidget(e->parent, e->x, e->y, e->w, e->h);
     }
 }
 
@@ -451,31 +424,41 @@ void axUpdateEntry(axEntry* e, axEvent* ev)
 void axFreeEntry(axEntry* e)
 {
     if (e) {
-        free(e->text);
-        free(e->place_holder);
+        text_buffer_free(&e->text);
+        free(offsets);
+        offsets = NULL;
+        offsets_cap = 0;
     }
 }
 
 /* --------------------------------------------------------------------- */
-/* Global registration (unchanged) */
+/* Registration */
 /* --------------------------------------------------------------------- */
-axEntry* entry_widgets[MAX_ENTRYS];
-int entrys_count = 0;
+static void entry_update(void* w, axEvent* ev) { axUpdateEntry((axEntry*)w, ev); }
+static void entry_render(void* w) { axRenderEntry((axEntry*)w); }
+static void entry_free(void* w) { axFreeEntry((axEntry*)w); }
+
+static bool entry_bounds(void* w, Rect* out) {
+    axEntry* e = (axEntry*)w;
+    if (!e->parent || !e->parent->is_open) return false;
+    *out = widget_visible_rect(&e->geom, e->parent, e->x, e->y, e->w, e->h);
+    return true;
+}
+
+const axWidgetClass entry_class = {
+    "entry", entry_update, entry_render, entry_free, entry_bounds, entry_bounds,
+    AX_PHASE_UPDATE_ENTRIES, AX_PHASE_RENDER_ENTRIES, AX_Z_WIDGETS, 0
+};
 
-void axRegisterEntry(axEntry* e) {
-    if (entrys_count < MAX_ENTRYS) entry_widgets[entrys_count++] = e;
+axWidgetHandle axRegisterEntry(axEntry* e) {
+    return axRegisterWidget(e, &entry_class);
 }
 void axRenderAllRegisteredEntries(void) {
-    for (int i = 0; i < entrys_count; ++i)
-        if (entry_widgets[i]) axRenderEntry(entry_widgets[i]);
+    registry_render_class(&entry_class);
 }
 void axUpdateAllRegisteredEntries(axEvent* ev) {
-    for (int i = 0; i < entrys_count; ++i)
-        if (entry_widgets[i]) axUpdateEntry(entry_widgets[i], ev);
+    registry_update_class(&entry_class, ev);
 }
 void axFreeAllRegisteredEntries(void) {
-    for (int i = 0; i < entrys_count; ++i) {
-        if (entry_widgets[i]) { axFreeEntry(entry_widgets[i]); entry_widgets[i] = NULL; }
-    }
-    entrys_count = 0;
+    axFreeAllWidgets(&entry_class);
 }
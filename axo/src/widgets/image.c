@@ -1,11 +1,22 @@
 /* image.c --------------------------------------------------------------- */
 #include "../../include/widgets/image.h"
+#include "../../include/core/theme.h"
+#include "../../include/core/redraw.h"
 #include "../../include/core/parent.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
 
 /* --------------------------------------------------------------------- */
+static axImageState state_of(const ImageHandle *handle)
+{
+    if (!handle) return AX_IMAGE_FAILED;
+    switch (handle->state) {
+        case IMAGE_LOADING: return AX_IMAGE_LOADING;
+        case IMAGE_FAILED:  return AX_IMAGE_FAILED;
+        default:            return AX_IMAGE_READY;
+    }
+}
 
 /* --------------------------------------------------------------------- */
 axImage axCreateImage(axParent *parent, int x, int y, const char *file_path, int w, int h)
@@ -28,9 +39,86 @@ axImage axCreateImage(axParent *parent, int x, int y, const char *file_path, int
     if (!img.handle) {
         printf("Failed to load image %s\n", file_path);
     }
+    img.state = state_of(img.handle);
+    return img;
+}
+
+/* --------------------------------------------------------------------- */
+axImage axCreateImageFromMemory(axParent *parent, int x, int y, const void *data, size_t size, int w, int h)
+{
+    if (!parent || !parent->base.sdl_renderer) {
+        printf("Invalid parent or renderer for image widget\n");
+        axImage img = {0};
+        return img;
+    }
+
+    axImage img = {0};
+    img.parent = parent;
+    img.x      = x;
+    img.y      = y;
+    img.w      = w;
+    img.h      = h;
+
+    img.handle = image_backend_load_mem(parent->base.sdl_renderer, data, size);
+    if (!img.handle) {
+        printf("Failed to load image from memory\n");
+    }
+    img.state = state_of(img.handle);
     return img;
 }
 
+/* --------------------------------------------------------------------- */
+axImage axCreateImageAsync(axParent *parent, int x, int y, const char *file_path, int w, int h)
+{
+    if (!parent || !parent->base.sdl_renderer) {
+        printf("Invalid parent or renderer for image widget\n");
+        axImage img = {0};
+        img.state = AX_IMAGE_FAILED;
+        return img;
+    }
+
+    axImage img = {0};
+    img.parent    = parent;
+    img.x         = x;
+    img.y         = y;
+    img.w         = w;
+    img.h         = h;
+    img.file_path = file_path;
+
+    img.handle = image_backend_load_async(parent->base.sdl_renderer, file_path);
+    if (!img.handle) {
+        printf("Failed to load image %s\n", file_path);
+    }
+    img.state = state_of(img.handle);
+    return img;
+}
+
+/* --------------------------------------------------------------------- */
+void axSetImageLoadCallback(axImage *image, axImageLoadFn fn, void *user_data)
+{
+    if (!image) return;
+    image->on_load   = fn;
+    image->user_data = user_data;
+}
+
+// Picks up a finished load: repaint, then tell the owner
+static void image_sync(axImage *image)
+{
+    if (image->state != AX_IMAGE_LOADING) return;
+    axImageState state = state_of(image->handle);
+    if (state == AX_IMAGE_LOADING) return;
+    image->state = state;
+    if (image->parent) axInvalidateWidget(image->parent, image->x, image->y, image->w, image->h);
+    if (image->on_load) image->on_load(image, state == AX_IMAGE_READY, image->user_data);
+}
+
+axImageState axGetImageState(axImage *image)
+{
+    if (!image) return AX_IMAGE_FAILED;
+    image_sync(image);
+    return image->state;
+}
+
 /* --------------------------------------------------------------------- */
 void axRenderImage(axImage *image)
 {
@@ -40,30 +128,28 @@ void axRenderImage(axImage *image)
     }
 
     Base *base = &image->parent->base;
-    float dpi  = base->dpi_scale;
 
     /* ----- DPI-scaled destination rectangle ----- */
-    int abs_x = image->x + image->parent->x;
-    int abs_y = image->y + image->parent->y + image->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(image->w * dpi);
-    int sh = (int)roundf(image->h * dpi);
-
-    /* ----- clipping (containers) ----- */
-    if (!image->parent->is_window) {
-        Rect pr = get_parent_rect(image->parent);
-        pr.x = (int)roundf(pr.x * dpi);
-        pr.y = (int)roundf(pr.y * dpi);
-        pr.w = (int)roundf(pr.w * dpi);
-        pr.h = (int)roundf(pr.h * dpi);
-        clip_begin(base, &pr);
-    } else {
-        clip_begin(base, NULL);
+    const Rect* g = widget_geom(&image->geom, image->parent, image->x, image->y, image->w, image->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
+
+    /* ----- clipping (containers) + culling ----- */
+    clip_begin(base, parent_clip_rect(image->parent));
+    Rect extent = { sx, sy, sw, sh };
+    if (!clip_visible(base, &extent)) {
+        clip_end(base);
+        return;
     }
 
     /* ----- delegate drawing to backend ----- */
-    image_backend_draw(base->sdl_renderer, image->handle, sx, sy, sw, sh);
+    if (image->handle->state == IMAGE_LOADING) {
+        draw_rect(base, sx, sy, sw, sh, current_theme->bg_secondary);   // placeholder
+    } else {
+        image_backend_draw(base->sdl_renderer, image->handle, sx, sy, sw, sh);
+    }
 
     clip_end(base);
 }
@@ -84,31 +170,48 @@ void axFreeImage(axImage *image)
 }
 
 /* --------------------------------------------------------------------- */
-/* Global registration (unchanged) */
-axImage* image_widgets[MAX_IMAGES];
-int    images_count = 0;
+/* Registration */
+/* --------------------------------------------------------------------- */
+static void image_update(void* w, axEvent* ev) { axUpdateImage((axImage*)w, ev); }
+static void image_render(void* w) { axRenderImage((axImage*)w); }
+static void image_free(void* w) { axFreeImage((axImage*)w); }
 
-void axRegisterImage(axImage* img)
+static bool image_extent(void* w, Rect* out)
 {
-    if (images_count < MAX_IMAGES) image_widgets[images_count++] = img;
+    axImage* img = (axImage*)w;
+    if (!img->parent || !img->parent->is_open) return false;
+    *out = widget_visible_rect(&img->geom, img->parent, img->x, img->y, img->w, img->h);
+    return out->w > 0 && out->h > 0;
+}
+
+// Takes no pointer input, so it stays out of the hit index
+const axWidgetClass image_class = {
+    "image", image_update, image_render, image_free, NULL, image_extent,
+    AX_PHASE_UPDATE_IMAGES, AX_PHASE_RENDER_IMAGES, AX_Z_WIDGETS, 0
+};
+
+axWidgetHandle axRegisterImage(axImage* img)
+{
+    return axRegisterWidget(img, &image_class);
 }
 void axRenderAllRegisteredImages(void)
 {
-    for (int i = 0; i < images_count; ++i)
-        if (image_widgets[i]) axRenderImage(image_widgets[i]);
+    registry_render_class(&image_class);
 }
 void axUpdateAllRegisteredImages(axEvent* ev)
 {
-    for (int i = 0; i < images_count; ++i)
-        if (image_widgets[i]) axUpdateImage(image_widgets[i], ev);
+    registry_update_class(&image_class, ev);
 }
 void axFreeAllRegisteredImages(void)
 {
-    for (int i = 0; i < images_count; ++i) {
-        if (image_widgets[i]) {
-            axFreeImage(image_widgets[i]);
-            image_widgets[i] = NULL;
-        }
+    axFreeAllWidgets(&image_class);
+}
+
+void image_sync_loads(void)
+{
+    int n;
+    const axWidgetEntry *widgets = axGetWidgets(&n);
+    for (int i = 0; i < n; i++) {
+        if (widgets[i].widget && widgets[i].cls == &image_class) image_sync((axImage *)widgets[i].widget);
     }
-    images_count = 0;
 }
@@ -36,23 +36,24 @@ axProgressBar axCreateProgressBar(axParent* parent, int x, int y, int w, int h,
 /* --------------------------------------------------------------------- */
 void axSetProgressBarBgColor(axProgressBar* p, Color c) {
     if (!p) return;
-    if (!p->custom_bg_color) p->custom_bg_color = malloc(sizeof(Color));
-    if (p->custom_bg_color) *p->custom_bg_color = c;
+    p->custom_bg_color = COLOR_OVERRIDE(c);
+    axInvalidateWidget(p->parent, p->x, p->y, p->w, p->h);
 }
 void axSetProgressBarFillColor(axProgressBar* p, Color c) {
     if (!p) return;
-    if (!p->custom_fill_color) p->custom_fill_color = malloc(sizeof(Color));
-    if (p->custom_fill_color) *p->custom_fill_color = c;
+    p->custom_fill_color = COLOR_OVERRIDE(c);
+    axInvalidateWidget(p->parent, p->x, p->y, p->w, p->h);
 }
 void axSetProgressBarTextColor(axProgressBar* p, Color c) {
     if (!p) return;
-    if (!p->custom_text_color) p->custom_text_color = malloc(sizeof(Color));
-    if (p->custom_text_color) *p->custom_text_color = c;
+    p->custom_text_color = COLOR_OVERRIDE(c);
+    axInvalidateWidget(p->parent, p->x, p->y, p->w, p->h);
 }
 void axSetProgressBarValue(axProgressBar* p, int value) {
     if (!p) return;
     if (value < p->min) value = p->min;
     if (value > p->max) value = p->max;
+    if (value != p->value) axInvalidateWidget(p->parent, p->x, p->y, p->w, p->h);
     p->value = value;
 }
 
@@ -63,34 +64,28 @@ void axRenderProgressBar(axProgressBar* p)
     if (!global_font) return;
 
     Base* base = &p->parent->base;
-    float dpi  = base->dpi_scale;
 
     /* ---------- DPI-SCALED VALUES ---------- */
-    int abs_x = p->x + p->parent->x;
-    int abs_y = p->y + p->parent->y + p->parent->title_height;
 
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(p->w * dpi);
-    int sh = (int)roundf(p->h * dpi);
+    const Rect* g = widget_geom(&p->geom, p->parent, p->x, p->y, p->w, p->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
     float roundness = current_theme->roundness;
 
-    /* ---------- PARENT CLIPPING (for containers) ---------- */
-    if (!p->parent->is_window) {
-        Rect pr = get_parent_rect(p->parent);           // our own Rect
-        pr.x = (int)roundf(pr.x * dpi);
-        pr.y = (int)roundf(pr.y * dpi);
-        pr.w = (int)roundf(pr.w * dpi);
-        pr.h = (int)roundf(pr.h * dpi);
-        clip_begin(base, &pr);
-    } else {
-        clip_begin(base, NULL);  // no clipping for root window
+    /* ---------- PARENT CLIPPING + CULLING ---------- */
+    clip_begin(base, parent_clip_rect(p->parent));
+    Rect extent = { sx, sy, sw, sh };
+    if (!clip_visible(base, &extent)) {
+        clip_end(base);
+        return;
     }
 
     /* ---------- COLORS ---------- */
-    Color bg   = p->custom_bg_color   ? *p->custom_bg_color   : current_theme->bg_secondary;
-    Color fill = p->custom_fill_color ? *p->custom_fill_color : current_theme->accent;
-    Color txt  = p->custom_text_color ? *p->custom_text_color : current_theme->text_primary;
+    Color bg   = color_or(p->custom_bg_color, current_theme->bg_secondary);
+    Color fill = color_or(p->custom_fill_color, current_theme->accent);
+    Color txt  = color_or(p->custom_text_color, current_theme->text_primary);
 
     /* ---------- DRAW BACKGROUND ---------- */
     draw_rounded_rect(base, sx, sy, sw, sh, roundness, bg);
@@ -131,42 +126,42 @@ void axUpdateProgressBar(axProgressBar* p, axEvent* ev)
 /* --------------------------------------------------------------------- */
 void axFreeProgressBar(axProgressBar* p)
 {
-    if (!p) return;
-    free(p->custom_bg_color);
-    free(p->custom_fill_color);
-    free(p->custom_text_color);
+    (void)p;   // colors are inline: nothing to release
 }
 
 /* --------------------------------------------------------------------- */
-/* Registration (unchanged) */
-axProgressBar* progress_bar_widgets[MAX_PROGRESS_BARS];
-int          progress_bars_count = 0;
+/* Registration */
+/* --------------------------------------------------------------------- */
+static void progress_bar_update(void* w, axEvent* ev) { axUpdateProgressBar((axProgressBar*)w, ev); }
+static void progress_bar_render(void* w) { axRenderProgressBar((axProgressBar*)w); }
 
-void axRegisterProgressBar(axProgressBar* p)
+static bool progress_bar_extent(void* w, Rect* out)
 {
-    if (progress_bars_count < MAX_PROGRESS_BARS)
-        progress_bar_widgets[progress_bars_count++] = p;
+    axProgressBar* p = (axProgressBar*)w;
+    if (!p->parent || !p->parent->is_open) return false;
+    *out = widget_visible_rect(&p->geom, p->parent, p->x, p->y, p->w, p->h);
+    return out->w > 0 && out->h > 0;
 }
 
+// Takes no pointer input, so it stays out of the hit index
+const axWidgetClass progress_bar_class = {
+    "progress bar", progress_bar_update, progress_bar_render, NULL, NULL, progress_bar_extent,
+    AX_PHASE_UPDATE_PROGRESSBARS, AX_PHASE_RENDER_PROGRESSBARS, AX_Z_WIDGETS, 0
+};
+
+axWidgetHandle axRegisterProgressBar(axProgressBar* p)
+{
+    return axRegisterWidget(p, &progress_bar_class);
+}
 void axRenderAllRegisteredProgressBars(void)
 {
-    for (int i = 0; i < progress_bars_count; ++i)
-        if (progress_bar_widgets[i]) axRenderProgressBar(progress_bar_widgets[i]);
+    registry_render_class(&progress_bar_class);
 }
-
 void axUpdateAllRegisteredProgressBars(axEvent* ev)
 {
-    for (int i = 0; i < progress_bars_count; ++i)
-        if (progress_bar_widgets[i]) axUpdateProgressBar(progress_bar_widgets[i], ev);
+    registry_update_class(&progress_bar_class, ev);
 }
-
 void axFreeAllRegisteredProgressBars(void)
 {
-    for (int i = 0; i < progress_bars_count; ++i) {
-        if (progress_bar_widgets[i]) {
-            axFreeProgressBar(progress_bar_widgets[i]);
-            progress_bar_widgets[i] = NULL;
-        }
-    }
-    progress_bars_count = 0;
+    axFreeAllWidgets(&progress_bar_class);
 }
@@ -2,6 +2,7 @@
 #include "../../include/widgets/radio.h"
 #include "../../include/core/theme.h"
 #include "../../axo.h"
+#include "../../include/core/intern.h"
 #include "../../include/core/parent.h"   // for Rect
 
 #include <stdlib.h>
@@ -26,27 +27,181 @@ axRadioButton axCreateRadioButton(axParent* parent, int x, int y, int w, int h,
     r.y          = y;
     r.w          = w;
     r.h          = h;
-    r.label      = label ? strdup(label) : NULL;
+    r.label      = intern_string(label);
     r.group_id   = group_id;
     return r;
 }
 
 /* --------------------------------------------------------------------- */
-/* Setters – unchanged */
+/* Setters */
+static Rect radio_draw_rect(axRadioButton* r);
+
+// Appearance changed: repaint everything the radio draws
+static void radio_invalidate(axRadioButton* r)
+{
+    if (r->parent && axGetRedrawMode() == AX_REDRAW_ON_DEMAND) axInvalidateRect(radio_draw_rect(r));
+}
+
 void axSetRadioButtonOuterColor(axRadioButton* r, Color c) {
     if (!r) return;
-    if (!r->custom_outer_color) r->custom_outer_color = malloc(sizeof(Color));
-    if (r->custom_outer_color) *r->custom_outer_color = c;
+    r->custom_outer_color = COLOR_OVERRIDE(c);
+    radio_invalidate(r);
 }
 void axSetRadioButtonInnerColor(axRadioButton* r, Color c) {
     if (!r) return;
-    if (!r->custom_inner_color) r->custom_inner_color = malloc(sizeof(Color));
-    if (r->custom_inner_color) *r->custom_inner_color = c;
+    r->custom_inner_color = COLOR_OVERRIDE(c);
+    radio_invalidate(r);
 }
 void axSetRadioButtonLabelColor(axRadioButton* r, Color c) {
     if (!r) return;
-    if (!r->custom_label_color) r->custom_label_color = malloc(sizeof(Color));
-    if (r->custom_label_color) *r->custom_label_color = c;
+    r->custom_label_color = COLOR_OVERRIDE(c);
+    radio_invalidate(r);
+}
+
+/* --------------------------------------------------------------------- */
+/* Groups */
+/* --------------------------------------------------------------------- */
+// Open-addressed table keyed by group_id; the selection lives on the
+// group, so a click touches the old and new selection and nothing else
+typedef struct {
+    int             id;
+    bool            used;
+    axRadioButton*  selected;
+    axRadioButton** members;
+    int             count, cap;
+    axRadioChangeFn on_change;
+} RadioGroup;
+
+static struct {
+    RadioGroup* slots;
+    int         count, cap;   // cap is a power of two
+} groups = {0};
+
+static bool grow(void** buf, int* cap, int need, size_t elem)
+{
+    if (need <= *cap) return true;
+    int new_cap = *cap ? *cap : 64;
+    while (new_cap < need) new_cap *= 2;
+    void* grown = realloc(*buf, elem * new_cap);
+    if (!grown) return false;
+    *buf = grown;
+    *cap = new_cap;
+    return true;
+}
+
+static int group_slot(const RadioGroup* slots, int cap, int id)
+{
+    int mask = cap - 1;
+    int i = (int)(((unsigned)id * 2654435769u) & (unsigned)mask);
+    while (slots[i].used && slots[i].id != id) i = (i + 1) & mask;
+    return i;
+}
+
+// The group with this id, or NULL if it does not exist and `create` is false
+static RadioGroup* find_group(int id, bool create)
+{
+    if (groups.cap > 0) {
+        RadioGroup* g = &groups.slots[group_slot(groups.slots, groups.cap, id)];
+        if (g->used) return g;
+    }
+    if (!create) return NULL;
+
+    // Keep the table at most half full
+    if ((groups.count + 1) * 2 > groups.cap) {
+        int cap = groups.cap ? groups.cap * 2 : 64;
+        RadioGroup* slots = calloc(cap, sizeof(RadioGroup));
+        if (!slots) {
+            printf("Failed to allocate radio group table\n");
+            return NULL;
+        }
+        for (int i = 0; i < groups.cap; i++) {
+            if (groups.slots[i].used) slots[group_slot(slots, cap, groups.slots[i].id)] = groups.slots[i];
+        }
+        free(groups.slots);
+        groups.slots = slots;
+        groups.cap = cap;
+    }
+    RadioGroup* g = &groups.slots[group_slot(groups.slots, groups.cap, id)];
+    g->id = id;
+    g->used = true;
+    groups.count++;
+    return g;
+}
+
+static void join_group(axRadioButton* r)
+{
+    RadioGroup* g = find_group(r->group_id, true);
+    if (!g) return;
+    if (!grow((void**)&g->members, &g->cap, g->count + 1, sizeof(axRadioButton*))) {
+        printf("Failed to add radio to group %d\n", r->group_id);
+        return;
+    }
+    g->members[g->count++] = r;
+    r->group_pos = g->count;
+    // A radio created selected keeps the selection only if the group has none
+    if (r->selected) {
+        if (g->selected) r->selected = false;
+        else g->selected = r;
+    }
+}
+
+// O(1): the last member takes the leaver's place. Safe to call twice.
+static void leave_group(axRadioButton* r)
+{
+    if (r->group_pos == 0) return;
+    RadioGroup* g = find_group(r->group_id, false);
+    int i = r->group_pos - 1;
+    r->group_pos = 0;
+    if (!g || i >= g->count || g->members[i] != r) return;
+    if (i < --g->count) {
+        g->members[i] = g->members[g->count];
+        g->members[i]->group_pos = i + 1;
+    }
+    if (g->selected == r) g->selected = NULL;
+}
+
+axRadioButton* axGetSelectedRadio(int group_id)
+{
+    RadioGroup* g = find_group(group_id, false);
+    return g ? g->selected : NULL;
+}
+
+axRadioButton* const* axGetRadioGroup(int group_id, int* count)
+{
+    RadioGroup* g = find_group(group_id, false);
+    if (count) *count = g ? g->count : 0;
+    return g ? g->members : NULL;
+}
+
+void axSetRadioGroupCallback(int group_id, axRadioChangeFn on_change)
+{
+    RadioGroup* g = find_group(group_id, true);
+    if (g) g->on_change = on_change;
+}
+
+void radio_groups_reset(void)
+{
+    for (int i = 0; i < groups.cap; i++) free(groups.slots[i].members);
+    free(groups.slots);
+    memset(&groups, 0, sizeof(groups));
+}
+
+/* --------------------------------------------------------------------- */
+// Physical rect the radio draws into: the circle centred on (x, y) and the
+// label to its right
+static Rect radio_draw_rect(axRadioButton* r)
+{
+    float dpi  = r->parent->base.dpi_scale;
+    const Rect* g = widget_geom(&r->geom, r->parent, r->x, r->y, r->w, r->h);
+    int sx     = g->x;
+    int sy     = g->y;
+    int sh     = g->h;
+    int radius = sh / 2;
+    int pad    = (int)roundf(current_theme->padding * dpi);
+    int label_w = (r->label && global_font) ? ttf_text_width(global_font, r->label) : 0;
+    int line_h  = global_font ? ttf_line_skip(global_font) : 0;
+    return (Rect){ sx - radius, sy - radius,
+                   radius + sh + pad / 2 + (label_w > 0 ? label_w : 0), sh + line_h };
 }
 
 /* --------------------------------------------------------------------- */
@@ -59,44 +214,38 @@ void axRenderRadioButton(axRadioButton* r)
     float dpi  = base->dpi_scale;
 
     /* ---------- DPI-SCALED VALUES ---------- */
-    int abs_x = r->x + r->parent->x;
-    int abs_y = r->y + r->parent->y + r->parent->title_height;
-
-    int sx     = (int)roundf(abs_x * dpi);
-    int sy     = (int)roundf(abs_y * dpi);
-    int sh     = (int)roundf(r->h * dpi);           // use height as size
+    const Rect* g = widget_geom(&r->geom, r->parent, r->x, r->y, r->w, r->h);
+    int sx     = g->x;
+    int sy     = g->y;
+    int sh     = g->h;                              // use height as size
     int radius = sh / 2;
     int pad    = (int)roundf(current_theme->padding * dpi);
     int inner_m = (int)roundf(4 * dpi);             // inner margin
     int inner_r = radius - inner_m;
 
-    /* ---------- PARENT CLIPPING (for containers) ---------- */
-    if (!r->parent->is_window) {
-        Rect pr = get_parent_rect(r->parent);       // our own Rect
-        pr.x = (int)roundf(pr.x * dpi);
-        pr.y = (int)roundf(pr.y * dpi);
-        pr.w = (int)roundf(pr.w * dpi);
-        pr.h = (int)roundf(pr.h * dpi);
-        clip_begin(base, &pr);
-    } else {
-        clip_begin(base, NULL);  // no clipping for root window
+    /* ---------- PARENT CLIPPING + CULLING ---------- */
+    clip_begin(base, parent_clip_rect(r->parent));
+    Rect extent = radio_draw_rect(r);
+    if (!clip_visible(base, &extent)) {
+        clip_end(base);
+        return;
     }
 
     /* ---------- COLORS ---------- */
-    Color outer = r->custom_outer_color ? *r->custom_outer_color : current_theme->bg_secondary;
+    Color outer = color_or(r->custom_outer_color, current_theme->bg_secondary);
     if (r->is_hovered) {
-        outer = r->custom_outer_color ? lighten_color(*r->custom_outer_color, 0.1f)
-                                      : current_theme->button_hovered;
+        outer = r->custom_outer_color.set ? lighten_color(r->custom_outer_color.color, 0.1f)
+                                          : current_theme->button_hovered;
     }
-    Color inner = r->custom_inner_color ? *r->custom_inner_color : current_theme->accent;
-    Color label = r->custom_label_color ? *r->custom_label_color : current_theme->text_primary;
+    Color inner = color_or(r->custom_inner_color, current_theme->accent);
+    Color label = color_or(r->custom_label_color, current_theme->text_primary);
 
     /* ---------- DRAW CIRCLE (outer) ---------- */
-    draw_circle(base, sx, sy, radius, outer);
+    draw_circle_aa(base, sx, sy, radius, outer);
 
     /* ---------- INNER DOT (if selected) ---------- */
     if (r->selected && inner_r > 0) {
-        draw_circle(base, sx, sy, inner_r, inner);
+        draw_circle_aa(base, sx, sy, inner_r, inner);
     }
 
     /* ---------- LABEL (to the right, vertically centered) ---------- */
@@ -104,8 +253,8 @@ void axRenderRadioButton(axRadioButton* r)
         int label_x = sx + sh + pad / 2;
         int label_y = sy - (sh / 6);   // fine-tuned centering
 
-        draw_text_from_font(base, global_font, r->label,
-                            label_x, label_y, label, ALIGN_LEFT);
+        draw_text_cached(base, global_font, r->label,
+                         label_x, label_y, label, ALIGN_LEFT);
     }
 
     /* ---------- RESTORE CLIP ---------- */
@@ -113,27 +262,52 @@ void axRenderRadioButton(axRadioButton* r)
 }
 
 /* --------------------------------------------------------------------- */
+// The circle is centred on (x, y); the label never changes with state
+static void invalidate_radio_dot(axRadioButton* r)
+{
+    axInvalidateWidget(r->parent, r->x - r->h / 2, r->y - r->h / 2, r->h, r->h);
+}
+
+void axSelectRadioButton(axRadioButton* r)
+{
+    if (!r) return;
+    RadioGroup* g = r->group_pos ? find_group(r->group_id, false) : NULL;
+    if (!g) {
+        // Not registered: no group to keep in step
+        r->selected = true;
+        return;
+    }
+    if (g->selected == r) return;
+    if (g->selected) {
+        g->selected->selected = false;
+        invalidate_radio_dot(g->selected);
+    }
+    g->selected = r;
+    r->selected = true;
+    invalidate_radio_dot(r);
+    if (g->on_change) g->on_change(r->group_id, r);
+}
+
 void axUpdateRadioButton(axRadioButton* r, axEvent* ev)
 {
     if (!r || !r->parent || !r->parent->is_open) return;
 
-    float dpi = r->parent->base.dpi_scale;
-
     /* ---------- DPI-SCALED ABSOLUTE POSITION ---------- */
-    int abs_x = r->x + r->parent->x;
-    int abs_y = r->y + r->parent->y + r->parent->title_height;
-    int sx    = (int)roundf(abs_x * dpi);
-    int sy    = (int)roundf(abs_y * dpi);
-    int sh    = (int)roundf(r->h * dpi);
+    const Rect* g = widget_geom(&r->geom, r->parent, r->x, r->y, r->w, r->h);
+    int sx    = g->x;
+    int sy    = g->y;
+    int sh    = g->h;
     int radius = sh / 2;
 
     /* ---------- HOVER (mouse position is in physical pixels) ---------- */
-    int mouse_x, mouse_y;
-    input_get_mouse(&mouse_x, &mouse_y);
-
-    int dx = mouse_x - sx;
-    int dy = mouse_y - sy;
-    r->is_hovered = (dx*dx + dy*dy <= radius*radius);
+    // Only pointer motion can change it
+    if (ev->type == EVENT_MOUSEMOTION) {
+        bool was_hovered = r->is_hovered;
+        int dx = ev->mouseMove.x - sx;
+        int dy = ev->mouseMove.y - sy;
+        r->is_hovered = (dx*dx + dy*dy <= radius*radius);
+        if (r->is_hovered != was_hovered) invalidate_radio_dot(r);
+    }
 
     /* ---------- CLICK ---------- */
     if (ev->type == EVENT_MOUSEBUTTONDOWN && ev->mouseButton.button == MOUSE_LEFT) {
@@ -141,54 +315,63 @@ void axUpdateRadioButton(axRadioButton* r, axEvent* ev)
         int my = ev->mouseButton.y;
         int dx = mx - sx;
         int dy = my - sy;
-        if (dx*dx + dy*dy <= radius*radius) {
-            // Deselect others in group
-            for (int i = 0; i < radios_count; ++i) {
-                if (radio_widgets[i] && radio_widgets[i]->group_id == r->group_id) {
-                    radio_widgets[i]->selected = false;
-                }
-            }
-            r->selected = true;
-        }
+        if (dx*dx + dy*dy <= radius*radius) axSelectRadioButton(r);
     }
 }
 
 /* --------------------------------------------------------------------- */
 void axFreeRadioButton(axRadioButton* r)
 {
-    if (!r) return;
-    free(r->label);
-    free(r->custom_outer_color);
-    free(r->custom_inner_color);
-    free(r->custom_label_color);
+    // label is interned and colors are inline: only the group refers to it
+    if (r) leave_group(r);
 }
 
 /* --------------------------------------------------------------------- */
-/* Global registration (unchanged) */
-axRadioButton* radio_widgets[MAX_RADIOS];
-int    radios_count = 0;
+/* Registration */
+/* --------------------------------------------------------------------- */
+static void radio_update(void* w, axEvent* ev) { axUpdateRadioButton((axRadioButton*)w, ev); }
+static void radio_render(void* w) { axRenderRadioButton((axRadioButton*)w); }
+static void radio_free(void* w) { axFreeRadioButton((axRadioButton*)w); }
+static void radio_unregistered(void* w) { leave_group((axRadioButton*)w); }
 
-void axRegisterRadioButton(axRadioButton* r)
+static bool radio_bounds(void* w, Rect* out)
 {
-    if (radios_count < MAX_RADIOS) radio_widgets[radios_count++] = r;
+    axRadioButton* r = (axRadioButton*)w;
+    if (!r->parent || !r->parent->is_open) return false;
+    // The circle is centred on (x, y)
+    *out = widget_visible_rect(&r->hit_geom, r->parent, r->x - r->h / 2, r->y - r->h / 2, r->h, r->h);
+    return out->w > 0 && out->h > 0;
+}
+
+static bool radio_extent(void* w, Rect* out)
+{
+    axRadioButton* r = (axRadioButton*)w;
+    if (!r->parent || !r->parent->is_open) return false;
+    *out = radio_draw_rect(r);
+    return clip_to_parent(r->parent, out);
+}
+
+const axWidgetClass radio_class = {
+    "radio", radio_update, radio_render, radio_free, radio_bounds, radio_extent,
+    AX_PHASE_UPDATE_RADIOS, AX_PHASE_RENDER_RADIOS, AX_Z_WIDGETS, 0,
+    radio_unregistered
+};
+
+axWidgetHandle axRegisterRadioButton(axRadioButton* r)
+{
+    axWidgetHandle h = axRegisterWidget(r, &radio_class);
+    if (h.generation) join_group(r);
+    return h;
 }
 void axRenderAllRegisteredRadioButtons(void)
 {
-    for (int i = 0; i < radios_count; ++i)
-        if (radio_widgets[i]) axRenderRadioButton(radio_widgets[i]);
+    registry_render_class(&radio_class);
 }
 void axUpdateAllRegisteredRadioButtons(axEvent* ev)
 {
-    for (int i = 0; i < radios_count; ++i)
-        if (radio_widgets[i]) axUpdateRadioButton(radio_widgets[i], ev);
+    registry_update_class(&radio_class, ev);
 }
 void axFreeAllRegisteredRadioButtons(void)
 {
-    for (int i = 0; i < radios_count; ++i) {
-        if (radio_widgets[i]) {
-            axFreeRadioButton(radio_widgets[i]);
-            radio_widgets[i] = NULL;
-        }
-    }
-    radios_count = 0;
+    axFreeAllWidgets(&radio_class);
 }
@@ -2,6 +2,7 @@
 #include "../../include/widgets/slider.h"
 #include "../../include/core/theme.h"
 #include "../../axo.h"
+#include "../../include/core/intern.h"
 #include "../../include/core/parent.h"   // for Rect
 
 #include <stdlib.h>
@@ -28,26 +29,53 @@ axSlider axCreateSlider(axParent* parent, int x, int y, int w, int h,
     s.min        = min;
     s.max        = max;
     s.value      = start_value;
-    s.label      = label ? strdup(label) : NULL;
+    s.label      = intern_string(label);
     return s;
 }
 
 /* --------------------------------------------------------------------- */
-/* Setters – unchanged */
+/* Setters */
+static Rect slider_draw_rect(axSlider* s);
+
+// Appearance changed: repaint everything the slider draws
+static void slider_invalidate(axSlider* s)
+{
+    if (s->parent && axGetRedrawMode() == AX_REDRAW_ON_DEMAND) axInvalidateRect(slider_draw_rect(s));
+}
+
 void axSetSliderTrackColor(axSlider* s, Color c) {
     if (!s) return;
-    if (!s->custom_track_color) s->custom_track_color = malloc(sizeof(Color));
-    if (s->custom_track_color) *s->custom_track_color = c;
+    s->custom_track_color = COLOR_OVERRIDE(c);
+    slider_invalidate(s);
 }
 void axSetSliderThumbColor(axSlider* s, Color c) {
     if (!s) return;
-    if (!s->custom_thumb_color) s->custom_thumb_color = malloc(sizeof(Color));
-    if (s->custom_thumb_color) *s->custom_thumb_color = c;
+    s->custom_thumb_color = COLOR_OVERRIDE(c);
+    slider_invalidate(s);
 }
 void axSetSliderLabelColor(axSlider* s, Color c) {
     if (!s) return;
-    if (!s->custom_label_color) s->custom_label_color = malloc(sizeof(Color));
-    if (s->custom_label_color) *s->custom_label_color = c;
+    s->custom_label_color = COLOR_OVERRIDE(c);
+    slider_invalidate(s);
+}
+
+/* --------------------------------------------------------------------- */
+// Physical rect the slider draws into: the thumb overhangs both ends of
+// the track, and the label sits to the right
+static Rect slider_draw_rect(axSlider* s)
+{
+    float dpi     = s->parent->base.dpi_scale;
+    const Rect* g = widget_geom(&s->geom, s->parent, s->x, s->y, s->w, s->h);
+    int sx        = g->x;
+    int sy        = g->y;
+    int sw        = g->w;
+    int sh        = g->h;
+    int thumb_w   = (int)roundf(10 * dpi);
+    int label_pad = (int)roundf(8 * dpi);
+    int label_w   = (s->label && global_font) ? ttf_text_width(global_font, s->label) : 0;
+    int line_h    = global_font ? ttf_line_skip(global_font) : 0;
+    return (Rect){ sx - thumb_w / 2, sy,
+                   sw + thumb_w + label_pad + (label_w > 0 ? label_w : 0), sh + line_h };
 }
 
 /* --------------------------------------------------------------------- */
@@ -60,13 +88,12 @@ void axRenderSlider(axSlider* s)
     float dpi  = base->dpi_scale;
 
     /* ---------- DPI-SCALED VALUES ---------- */
-    int abs_x = s->x + s->parent->x;
-    int abs_y = s->y + s->parent->y + s->parent->title_height;
 
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(s->w * dpi);
-    int sh = (int)roundf(s->h * dpi);
+    const Rect* g = widget_geom(&s->geom, s->parent, s->x, s->y, s->w, s->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
 
     int track_h     = (int)roundf(4 * dpi);
     int thumb_w     = (int)roundf(10 * dpi);
@@ -74,24 +101,20 @@ void axRenderSlider(axSlider* s)
     int label_pad   = (int)roundf(8 * dpi);
     int label_v_offset = (int)roundf(2 * dpi);
 
-    /* ---------- PARENT CLIPPING (for containers) ---------- */
-    if (!s->parent->is_window) {
-        Rect pr = get_parent_rect(s->parent);           // our own Rect
-        pr.x = (int)roundf(pr.x * dpi);
-        pr.y = (int)roundf(pr.y * dpi);
-        pr.w = (int)roundf(pr.w * dpi);
-        pr.h = (int)roundf(pr.h * dpi);
-        clip_begin(base, &pr);
-    } else {
-        clip_begin(base, NULL);  // no clipping for root window
+    /* ---------- PARENT CLIPPING + CULLING ---------- */
+    clip_begin(base, parent_clip_rect(s->parent));
+    Rect extent = slider_draw_rect(s);
+    if (!clip_visible(base, &extent)) {
+        clip_end(base);
+        return;
     }
 
     /* ---------- COLORS ---------- */
-    Color track = s->custom_track_color ? *s->custom_track_color : current_theme->bg_secondary;
-    Color thumb = s->custom_thumb_color ? *s->custom_thumb_color : current_theme->accent;
+    Color track = color_or(s->custom_track_color, current_theme->bg_secondary);
+    Color thumb = color_or(s->custom_thumb_color, current_theme->accent);
     if (s->is_hovered || s->dragging) {
-        thumb = s->custom_thumb_color ? lighten_color(*s->custom_thumb_color, 0.1f)
-                                      : current_theme->button_hovered;
+        thumb = s->custom_thumb_color.set ? lighten_color(s->custom_thumb_color.color, 0.1f)
+                                          : current_theme->button_hovered;
     }
 
     /* ---------- TRACK (centered vertically) ---------- */
@@ -108,10 +131,10 @@ void axRenderSlider(axSlider* s)
 
     /* ---------- LABEL (if any) ---------- */
     if (s->label) {
-        Color label_col = s->custom_label_color ? *s->custom_label_color : current_theme->text_secondary;
+        Color label_col = color_or(s->custom_label_color, current_theme->text_secondary);
         int label_x = sx + sw + label_pad;
         int label_y = sy + (sh / 2) - label_v_offset;
-        draw_text_from_font(base, global_font, s->label, label_x, label_y, label_col, ALIGN_LEFT);
+        draw_text_cached(base, global_font, s->label, label_x, label_y, label_col, ALIGN_LEFT);
     }
 
     /* ---------- RESTORE CLIP ---------- */
@@ -126,12 +149,11 @@ void axUpdateSlider(axSlider* s, axEvent* ev)
     float dpi = s->parent->base.dpi_scale;
 
     /* ---------- DPI-SCALED ABSOLUTE POSITION ---------- */
-    int abs_x = s->x + s->parent->x;
-    int abs_y = s->y + s->parent->y + s->parent->title_height;
-    int sx    = (int)roundf(abs_x * dpi);
-    int sy    = (int)roundf(abs_y * dpi);
-    int sw    = (int)roundf(s->w  * dpi);
-    int sh    = (int)roundf(s->h  * dpi);
+    const Rect* g = widget_geom(&s->geom, s->parent, s->x, s->y, s->w, s->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
     int thumb_w = (int)roundf(10 * dpi);
 
     /* ---------- THUMB PHYSICAL BOUNDS ---------- */
@@ -141,6 +163,10 @@ void axUpdateSlider(axSlider* s, axEvent* ev)
     int thumb_left  = thumb_x - thumb_w / 2;
     int thumb_right = thumb_x + thumb_w / 2;
 
+    bool was_hovered  = s->is_hovered;
+    bool was_dragging = s->dragging;
+    int  old_value    = s->value;
+
     /* ---------- MOUSE STATE (physical pixels) ---------- */
     int mouse_x, mouse_y;
     input_get_mouse(&mouse_x, &mouse_y);
@@ -169,44 +195,60 @@ void axUpdateSlider(axSlider* s, axEvent* ev)
     else if (ev->type == EVENT_MOUSEBUTTONUP && ev->mouseButton.button == MOUSE_LEFT) {
         s->dragging = false;
     }
+
+    if (s->is_hovered != was_hovered || s->dragging != was_dragging || s->value != old_value) {
+        // The thumb hangs half its width over either end of the track
+        axInvalidateWidget(s->parent, s->x - 5, s->y, s->w + 10, s->h);
+    }
 }
 
 /* --------------------------------------------------------------------- */
 void axFreeSlider(axSlider* s)
 {
-    if (!s) return;
-    free(s->label);
-    free(s->custom_track_color);
-    free(s->custom_thumb_color);
-    free(s->custom_label_color);
+    (void)s;   // label is interned and colors are inline: nothing to release
 }
 
 /* --------------------------------------------------------------------- */
-/* Global registration (unchanged) */
-axSlider* sliders[MAX_SLIDERS];
-int     sliders_count = 0;
+/* Registration */
+/* --------------------------------------------------------------------- */
+static void slider_update(void* w, axEvent* ev) { axUpdateSlider((axSlider*)w, ev); }
+static void slider_render(void* w) { axRenderSlider((axSlider*)w); }
+
+static bool slider_bounds(void* w, Rect* out)
+{
+    axSlider* s = (axSlider*)w;
+    if (!s->parent || !s->parent->is_open) return false;
+    // The thumb hangs half its width over either end of the track
+    *out = widget_visible_rect(&s->hit_geom, s->parent, s->x - 5, s->y, s->w + 10, s->h);
+    return out->w > 0 && out->h > 0;
+}
 
-void axRegisterSlider(axSlider* s)
+static bool slider_extent(void* w, Rect* out)
 {
-    if (sliders_count < MAX_SLIDERS) sliders[sliders_count++] = s;
+    axSlider* s = (axSlider*)w;
+    if (!s->parent || !s->parent->is_open) return false;
+    *out = slider_draw_rect(s);
+    return clip_to_parent(s->parent, out);
+}
+
+const axWidgetClass slider_class = {
+    "slider", slider_update, slider_render, NULL, slider_bounds, slider_extent,
+    AX_PHASE_UPDATE_SLIDERS, AX_PHASE_RENDER_SLIDERS, AX_Z_WIDGETS, 0
+};
+
+axWidgetHandle axRegisterSlider(axSlider* s)
+{
+    return axRegisterWidget(s, &slider_class);
 }
 void axRenderAllRegisteredSliders(void)
 {
-    for (int i = 0; i < sliders_count; ++i)
-        if (sliders[i]) axRenderSlider(sliders[i]);
+    registry_render_class(&slider_class);
 }
 void axUpdateAllRegisteredSliders(axEvent* ev)
 {
-    for (int i = 0; i < sliders_count; ++i)
-        if (sliders[i]) axUpdateSlider(sliders[i], ev);
+    registry_update_class(&slider_class, ev);
 }
 void axFreeAllRegisteredSliders(void)
 {
-    for (int i = 0; i < sliders_count; ++i) {
-        if (sliders[i]) {
-            axFreeSlider(sliders[i]);
-            sliders[i] = NULL;
-        }
-    }
-    sliders_count = 0;
+    axFreeAllWidgets(&slider_class);
 }
@@ -2,6 +2,7 @@
 #include "../../include/widgets/text.h"
 #include "../../include/core/theme.h"
 #include "../../axo.h"
+#include "../../include/core/intern.h"
 #include "../../include/core/parent.h"   // for Rect
 
 #include <stdlib.h>
@@ -23,12 +24,25 @@ axText axCreateText(axParent* parent, int x, int y, const char* content,
     t.parent     = parent;
     t.x          = x;
     t.y          = y;
-    t.content    = content ? strdup(content) : NULL;
+    t.content    = intern_string(content);
     t.font_size  = font_size;
     t.align      = align;
     return t;
 }
 
+/* --------------------------------------------------------------------- */
+// Physical rect the text draws into, after alignment
+static Rect text_draw_rect(axText* t)
+{
+    const Rect* g = widget_geom(&t->geom, t->parent, t->x, t->y, 0, 0);
+    int sx = g->x;
+    int sy = g->y;
+    int text_w = (t->content && global_font) ? ttf_text_width(global_font, t->content) : 0;
+    if (text_w < 0) text_w = 0;
+    int left = t->align == ALIGN_CENTER ? sx - text_w / 2 : t->align == ALIGN_RIGHT ? sx - text_w : sx;
+    return (Rect){ left, sy, text_w, global_font ? ttf_line_skip(global_font) : 0 };
+}
+
 /* --------------------------------------------------------------------- */
 void axRenderText(axText* t)
 {
@@ -37,37 +51,30 @@ void axRenderText(axText* t)
     if (!global_font) { printf("global_font missing\n"); return; }
 
     Base* base = &t->parent->base;
-    float dpi  = base->dpi_scale;
 
     /* ---------- DPI-SCALED VALUES ---------- */
-    int abs_x = t->x + t->parent->x;
-    int abs_y = t->y + t->parent->y + t->parent->title_height;
-
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-
-    /* ---------- PARENT CLIPPING (for containers) ---------- */
-    if (!t->parent->is_window) {
-        Rect pr = get_parent_rect(t->parent);           // our own Rect
-        pr.x = (int)roundf(pr.x * dpi);
-        pr.y = (int)roundf(pr.y * dpi);
-        pr.w = (int)roundf(pr.w * dpi);
-        pr.h = (int)roundf(pr.h * dpi);
-        clip_begin(base, &pr);
-    } else {
-        clip_begin(base, NULL);  // no clipping for root window
+    const Rect* g = widget_geom(&t->geom, t->parent, t->x, t->y, 0, 0);
+    int sx = g->x;
+    int sy = g->y;
+
+    /* ---------- PARENT CLIPPING + CULLING ---------- */
+    clip_begin(base, parent_clip_rect(t->parent));
+    Rect extent = text_draw_rect(t);
+    if (!clip_visible(base, &extent)) {
+        clip_end(base);
+        return;
     }
 
     /* ---------- COLOR ---------- */
-    Color col = t->color ? *t->color : current_theme->text_primary;
+    Color col = color_or(t->color, current_theme->text_primary);
 
     /* ---------- RENDER TEXT (physical pixels, DPI-scaled font) ---------- */
-    draw_text_from_font(base,
-                        global_font,
-                        t->content,
-                        sx, sy,
-                        col,
-                        t->align);
+    draw_text_cached(base,
+                     global_font,
+                     t->content,
+                     sx, sy,
+                     col,
+                     t->align);
 
     /* ---------- RESTORE CLIP ---------- */
     clip_end(base);
@@ -77,11 +84,31 @@ void axRenderText(axText* t)
 void axSetTextColor(axText* t, Color c)
 {
     if (!t) return;
-    if (!t->color) {
-        t->color = malloc(sizeof(Color));
-        if (!t->color) { printf("malloc failed for text color\n"); return; }
+    t->color = COLOR_OVERRIDE(c);
+    if (t->parent && axGetRedrawMode() == AX_REDRAW_ON_DEMAND) axInvalidateRect(text_draw_rect(t));
+}
+
+void axSetTextContent(axText* t, const char* content)
+{
+    if (!t) return;
+    if (!content) content = "";
+    if (t->content && strcmp(t->content, content) == 0) return;
+
+    int need = (int)strlen(content) + 1;
+    if (need > t->owned_cap) {
+        char* grown = realloc(t->owned, need);
+        if (!grown) {
+            printf("Failed to set text content\n");
+            return;
+        }
+        t->owned = grown;
+        t->owned_cap = need;
     }
-    *t->color = c;
+    bool repaint = t->parent && axGetRedrawMode() == AX_REDRAW_ON_DEMAND;
+    if (repaint) axInvalidateRect(text_draw_rect(t));   // the old text
+    memcpy(t->owned, content, need);
+    t->content = t->owned;
+    if (repaint) axInvalidateRect(text_draw_rect(t));
 }
 
 /* --------------------------------------------------------------------- */
@@ -94,36 +121,46 @@ void axUpdateText(axText* t, axEvent* ev)
 void axFreeText(axText* t)
 {
     if (!t) return;
-    free(t->content);
-    free(t->color);
+    // Interned content belongs to the pool; only a changed one is ours
+    if (t->owned && t->content == t->owned) t->content = NULL;
+    free(t->owned);
+    t->owned = NULL;
+    t->owned_cap = 0;
 }
 
 /* --------------------------------------------------------------------- */
-/* Global registration (unchanged) */
-axText* text_widgets[MAX_TEXTS];
-int   texts_count = 0;
+/* Registration */
+/* --------------------------------------------------------------------- */
+static void text_update(void* w, axEvent* ev) { axUpdateText((axText*)w, ev); }
+static void text_render(void* w) { axRenderText((axText*)w); }
+
+static bool text_extent(void* w, Rect* out)
+{
+    axText* t = (axText*)w;
+    if (!t->parent || !t->parent->is_open) return false;
+    *out = text_draw_rect(t);
+    return clip_to_parent(t->parent, out);
+}
+
+// Takes no pointer input, so it stays out of the hit index
+const axWidgetClass text_class = {
+    "text", text_update, text_render, NULL, NULL, text_extent,
+    AX_PHASE_UPDATE_TEXTS, AX_PHASE_RENDER_TEXTS, AX_Z_WIDGETS, 0
+};
 
-void axRegisterText(axText* t)
+axWidgetHandle axRegisterText(axText* t)
 {
-    if (texts_count < MAX_TEXTS) text_widgets[texts_count++] = t;
+    return axRegisterWidget(t, &text_class);
 }
 void axRenderAllRegisteredTexts(void)
 {
-    for (int i = 0; i < texts_count; ++i)
-        if (text_widgets[i]) axRenderText(text_widgets[i]);
+    registry_render_class(&text_class);
 }
 void axUpdateAllRegisteredTexts(axEvent* ev)
 {
-    for (int i = 0; i < texts_count; ++i)
-        if (text_widgets[i]) axUpdateText(text_widgets[i], ev);
+    registry_update_class(&text_class, ev);
 }
 void axFreeAllRegisteredTexts(void)
 {
-    for (int i = 0; i < texts_count; ++i) {
-        if (text_widgets[i]) {
-            axFreeText(text_widgets[i]);
-            text_widgets[i] = NULL;
-        }
-    }
-    texts_count = 0;
+    axFreeAllWidgets(&text_class);
 }
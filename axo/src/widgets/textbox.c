@@ -2,6 +2,7 @@
 #include "../../include/core/theme.h"
 #include "../../include/core/color.h"
 #include "../../axo.h"
+#include "../../include/core/intern.h"
 #include "../../include/core/parent.h"   // for Rect
 #include <stdio.h>
 #include <stdlib.h>
@@ -22,7 +23,7 @@ axTextBox axCreateTextBox(axParent* parent, int x, int y, int w, int max_length)
 
     axTextBox new_textbox;
     new_textbox.parent = parent;
-    new_textbox.place_holder = strdup(" ");
+    new_textbox.place_holder = intern_string(" ");
     if (!new_textbox.place_holder) {
         printf("Failed to allocate memory for placeholder\n");
     }
@@ -31,17 +32,16 @@ axTextBox axCreateTextBox(axParent* parent, int x, int y, int w, int max_length)
     new_textbox.w = w;
     new_textbox.h = 10 * (current_theme->default_font_size + current_theme->padding / 2);
     new_textbox.max_length = max_length;
-    new_textbox.text = (char*)malloc(max_length + 1);
-    if (!new_textbox.text) {
+    if (!text_buffer_init(&new_textbox.text, max_length)) {
         printf("Failed to allocate memory for textbox text\n");
-        free(new_textbox.place_holder);
     }
-    new_textbox.text[0] = '\0';
     new_textbox.is_active = 0;
     new_textbox.cursor_pos = 0;
     new_textbox.selection_start = -1;
     new_textbox.visible_line_start = 0;
     new_textbox.is_mouse_selecting = 0;
+    memset(&new_textbox.wrap, 0, sizeof(new_textbox.wrap));
+    memset(&new_textbox.geom, 0, sizeof(new_textbox.geom));
 
     // Use global_font (already DPI-scaled)
     if (global_font) {
@@ -56,6 +56,247 @@ axTextBox axCreateTextBox(axParent* parent, int x, int y, int w, int max_length)
     return new_textbox;
 }
 
+/* ---------- measuring ---------- */
+// Caret x of every byte of text[0, len) (len + 1 entries).
+// The buffer is shared and only valid until the next call.
+static const int* line_offsets(Font_ttf* font, const char* text, int len) {
+    static int* offsets = NULL;
+    static int cap = 0;
+    if (len + 1 > cap) {
+        int new_cap = cap ? cap : 256;
+        while (new_cap < len + 1) new_cap *= 2;
+        int* grown = (int*)realloc(offsets, sizeof(int) * new_cap);
+        if (!grown) return NULL;
+        offsets = grown;
+        cap = new_cap;
+    }
+    ttf_measure_prefix_widths_n(font, text, len, offsets);
+    return offsets;
+}
+
+/* ---------- wrap index ---------- */
+static int wrap_reserve(WrapIndex* wi, int n) {
+    if (n <= wi->cap) return 1;
+    int cap = wi->cap ? wi->cap : 64;
+    while (cap < n) cap *= 2;
+    Line* grown = (Line*)realloc(wi->lines, sizeof(Line) * cap);
+    if (!grown) return 0;
+    wi->lines = grown;
+    wi->cap = cap;
+    return 1;
+}
+
+static int wrap_push(WrapIndex* wi, int start, int len) {
+    if (!wrap_reserve(wi, wi->count + 1)) return 0;
+    wi->lines[wi->count].start = start;
+    wi->lines[wi->count].len = len;
+    wi->count++;
+    return 1;
+}
+
+// Appends the visual lines of text[0, len) to `out`, numbering them from
+// `base`. The range must cover whole paragraphs.
+static int wrap_range(WrapIndex* out, const char* text, int base, int len, int max_width, Font_ttf* font) {
+    int line_start = 0;
+    for (int pos = 0; pos <= len; pos++) {
+        if (pos == len || text[pos] == '\n') {
+            int seg_start = line_start;
+            int seg_len = pos - line_start;
+            int seg_pos = 0;
+            const int* offsets = seg_len > 0 ? line_offsets(font, text + seg_start, seg_len) : NULL;
+            if (seg_len > 0 && !offsets) return 0;
+            while (seg_pos < seg_len) {
+                int line_start_local = seg_pos;
+                int last_space = -1;
+                int current_width = 0;
+                while (seg_pos < seg_len) {
+                    int char_w = offsets[seg_pos + 1] - offsets[seg_pos];
+                    if (current_width + char_w > max_width) {
+                        if (current_width == 0) {
+                            current_width += char_w;
+                            if (isspace((unsigned char)text[seg_start + seg_pos])) last_space = seg_pos;
+                            seg_pos++;
+                            continue;
+                        }
+                        int add_len = (last_space != -1) ? (last_space - line_start_local) : (seg_pos - line_start_local);
+                        if (add_len > 0 && !wrap_push(out, base + seg_start + line_start_local, add_len)) return 0;
+                        line_start_local = seg_pos = last_space != -1 ? last_space + 1 : seg_pos;
+                        current_width = 0;
+                        last_space = -1;
+                        continue;
+                    }
+                    current_width += char_w;
+                    if (isspace((unsigned char)text[seg_start + seg_pos])) last_space = seg_pos;
+                    seg_pos++;
+                }
+                int add_len = seg_pos - line_start_local;
+                if (add_len > 0 && !wrap_push(out, base + seg_start + line_start_local, add_len)) return 0;
+            }
+            if (seg_len == 0 && !wrap_push(out, base + seg_start, 0)) return 0;
+            line_start = pos + 1;
+        }
+    }
+    return 1;
+}
+
+// Physical text area inside the border and padding; wrapping, scrolling,
+// rendering and hit-testing all measure against it
+static Rect textbox_text_rect(axTextBox* textbox) {
+    float dpi = textbox->parent->base.dpi_scale;
+    const Rect* g = widget_geom(&textbox->geom, textbox->parent, textbox->x, textbox->y, textbox->w, textbox->h);
+    int inset = (int)roundf(2 * dpi) + (int)roundf(current_theme->padding * dpi);
+    return (Rect){ g->x + inset, g->y + inset, g->w - 2 * inset, g->h - 2 * inset };
+}
+
+// Returns the up-to-date wrap of textbox->text, rebuilding it if the wrap
+// width or font changed or the text was replaced
+static WrapIndex* textbox_wrap(axTextBox* textbox, int width, Font_ttf* font) {
+    WrapIndex* wi = &textbox->wrap;
+    int len = textbox->text.length;
+    if (!wi->valid || wi->width != width || wi->font != font || wi->text_len != len) {
+        wi->count = 0;
+        wi->width = width;
+        wi->font = font;
+        wi->text_len = len;
+        wi->valid = wrap_range(wi, text_buffer_range(&textbox->text, 0, len), 0, len, width, font);
+    }
+    return wi;
+}
+
+// First visual line whose [start, start + len] contains pos, or -1
+static int wrap_line_of(const WrapIndex* wi, int pos) {
+    int lo = 0, hi = wi->count - 1, found = -1;
+    while (lo <= hi) {   // last line starting at or before pos
+        int mid = (lo + hi) / 2;
+        if (wi->lines[mid].start <= pos) { found = mid; lo = mid + 1; }
+        else hi = mid - 1;
+    }
+    if (found < 0) return -1;
+    if (found > 0 && wi->lines[found - 1].start + wi->lines[found - 1].len >= pos) return found - 1;
+    return pos <= wi->lines[found].start + wi->lines[found].len ? found : -1;
+}
+
+// First line index with start > pos (or >= pos when `inclusive` is 0)
+static int wrap_lower_bound(const WrapIndex* wi, int pos, int inclusive) {
+    int lo = 0, hi = wi->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int before = inclusive ? wi->lines[mid].start <= pos : wi->lines[mid].start < pos;
+        if (before) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Scratch indexes shared by every textbox: the re-wrapped paragraphs of an
+// edit, and the placeholder. Dropped whenever a textbox is freed, so
+// axFreeAllWidgets leaves nothing behind; they regrow on the next use.
+static WrapIndex splice_wrap;
+static WrapIndex placeholder_wrap;
+
+static void wrap_scratch_free(void) {
+    free(splice_wrap.lines);
+    free(placeholder_wrap.lines);
+    memset(&splice_wrap, 0, sizeof(splice_wrap));
+    memset(&placeholder_wrap, 0, sizeof(placeholder_wrap));
+}
+
+// Splices a fresh wrap of the paragraphs touched by an edit into the index.
+// The edit replaced `removed` bytes at `pos` with `inserted` bytes.
+static void textbox_text_changed(axTextBox* textbox, int pos, int removed, int inserted) {
+    WrapIndex* wi = &textbox->wrap;
+    if (!wi->valid) return;
+
+    TextBuffer* buf = &textbox->text;
+    int len = buf->length;
+    int delta = inserted - removed;
+
+    int para_start = pos;
+    while (para_start > 0 && text_buffer_at(buf, para_start - 1) != '\n') para_start--;
+    int para_end = pos + inserted;
+    while (para_end < len && text_buffer_at(buf, para_end) != '\n') para_end++;
+
+    // Old lines of the same paragraphs: start in [para_start, para_end - delta]
+    int first = wrap_lower_bound(wi, para_start, 0);
+    int last = wrap_lower_bound(wi, para_end - delta, 1);
+
+    splice_wrap.count = 0;
+    int para_len = para_end - para_start;
+    if (!wrap_range(&splice_wrap, text_buffer_range(buf, para_start, para_len), para_start, para_len, wi->width, wi->font) ||
+        !wrap_reserve(wi, wi->count - (last - first) + splice_wrap.count)) {
+        wi->valid = 0;
+        return;
+    }
+
+    memmove(wi->lines + first + splice_wrap.count, wi->lines + last, sizeof(Line) * (wi->count - last));
+    memcpy(wi->lines + first, splice_wrap.lines, sizeof(Line) * splice_wrap.count);
+    wi->count += splice_wrap.count - (last - first);
+    for (int i = first + splice_wrap.count; i < wi->count; i++) wi->lines[i].start += delta;
+    wi->text_len = len;
+}
+
+/* ---------- editing ---------- */
+// Every edit goes through here so the wrap index re-wraps just the touched paragraphs
+static int textbox_replace(axTextBox* textbox, int pos, int remove_len, const char* s, int n) {
+    if (!text_buffer_replace(&textbox->text, pos, remove_len, s, n)) return 0;
+    textbox_text_changed(textbox, pos, remove_len, n);
+    return 1;
+}
+
+static void textbox_apply_change(axTextBox* textbox, const TextChange* change) {
+    textbox_text_changed(textbox, change->pos, change->removed, change->inserted);
+    textbox->cursor_pos = change->cursor;
+    textbox->selection_start = -1;
+}
+
+// Replaces the selection (or inserts at the cursor) with s[0, n)
+static int textbox_replace_selection(axTextBox* textbox, const char* s, int n) {
+    int sel_start = textbox->cursor_pos, sel_end = textbox->cursor_pos;
+    if (textbox->selection_start != -1) {
+        sel_start = textbox->selection_start < textbox->cursor_pos ? textbox->selection_start : textbox->cursor_pos;
+        sel_end = textbox->selection_start < textbox->cursor_pos ? textbox->cursor_pos : textbox->selection_start;
+    }
+    if (!textbox_replace(textbox, sel_start, sel_end - sel_start, s, n)) return 0;
+    textbox->cursor_pos = sel_start + n;
+    textbox->selection_start = -1;
+    return 1;
+}
+
+// Cursor position under the physical point (px, py)
+static int textbox_hit_test(axTextBox* textbox, int px, int py) {
+    Font_ttf* font = global_font;
+    Rect area = textbox_text_rect(textbox);
+    WrapIndex* wi = textbox_wrap(textbox, area.w, font);
+    int line_h = ttf_line_skip(font);
+    if (line_h <= 0) line_h = textbox->line_height;
+
+    int click_y = py - area.y;
+    int clicked_line = textbox->visible_line_start + (click_y > 0 ? click_y / line_h : 0);
+    if (clicked_line >= wi->count) return textbox->text.length;
+
+    Line l = wi->lines[clicked_line];
+    const char* line = text_buffer_range(&textbox->text, l.start, l.len);
+    const int* offsets = line_offsets(font, line, l.len);
+    if (!offsets) return l.start;
+    return l.start + ttf_caret_at_x(line, offsets, l.len, px - area.x);
+}
+
+const char* axTextBoxGetText(axTextBox* textbox) {
+    return textbox ? text_buffer_cstr(&textbox->text) : "";
+}
+
+void axTextBoxSetText(axTextBox* textbox, const char* text) {
+    if (!textbox) return;
+    text_buffer_set(&textbox->text, text);
+    textbox->cursor_pos = textbox->text.length;
+    textbox->selection_start = -1;
+    textbox->wrap.valid = 0;
+    if (textbox->parent) {
+        update_visible_lines(textbox);
+        axInvalidateWidget(textbox->parent, textbox->x, textbox->y, textbox->w, textbox->h);
+    }
+}
+
 void axRenderTextBox(axTextBox* textbox) {
     if (!textbox || !textbox->parent || !textbox->parent->base.sdl_renderer || !textbox->parent->is_open) {
         printf("Invalid textbox, renderer, or parent is not open\n");
@@ -64,25 +305,12 @@ void axRenderTextBox(axTextBox* textbox) {
 
     float dpi = textbox->parent->base.dpi_scale;
 
-    // Parent clip
-    Rect parent_clip = {0,0,0,0};
-    int has_parent_clip = 0;
-    if (!textbox->parent->is_window) {
-        Rect pr = get_parent_rect(textbox->parent);
-        parent_clip.x = (int)roundf(pr.x * dpi);
-        parent_clip.y = (int)roundf(pr.y * dpi);
-        parent_clip.w = (int)roundf(pr.w * dpi);
-        parent_clip.h = (int)roundf(pr.h * dpi);
-        has_parent_clip = 1;
-    }
-
     // Physical bounds
-    int abs_x = textbox->x + textbox->parent->x;
-    int abs_y = textbox->y + textbox->parent->y + textbox->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(textbox->w * dpi);
-    int sh = (int)roundf(textbox->h * dpi);
+    const Rect* g = widget_geom(&textbox->geom, textbox->parent, textbox->x, textbox->y, textbox->w, textbox->h);
+    int sx = g->x;
+    int sy = g->y;
+    int sw = g->w;
+    int sh = g->h;
     int border_width = (int)roundf(2 * dpi);
     int padding = (int)roundf(current_theme->padding * dpi);
 
@@ -95,8 +323,12 @@ void axRenderTextBox(axTextBox* textbox) {
 
     int font_height = ttf_line_skip(font);
 
-    if (has_parent_clip) {
-        clip_begin(&textbox->parent->base, &parent_clip);
+    // Parent clip, and nothing to draw if the textbox is outside it
+    clip_begin(&textbox->parent->base, parent_clip_rect(textbox->parent));
+    Rect extent = { sx, sy, sw, sh };
+    if (!clip_visible(&textbox->parent->base, &extent)) {
+        clip_end(&textbox->parent->base);
+        return;
     }
 
     // Background & border
@@ -106,40 +338,35 @@ void axRenderTextBox(axTextBox* textbox) {
                sw - 2*border_width, sh - 2*border_width,
                current_theme->bg_secondary);
 
-    if (has_parent_clip) {
-        clip_end(&textbox->parent->base);
-    }
-
-    // Text clip
+    // Text clip, nested in the parent clip
     Rect text_clip = {
         sx + border_width + padding,
         sy + border_width + padding,
         sw - 2*(border_width + padding),
         sh - 2*(border_width + padding)
     };
-    Rect effective_text;
-    if (has_parent_clip) {
-        if (!rect_intersect(&parent_clip, &text_clip, &effective_text)) {
-            return;
-        }
-    } else {
-        effective_text = text_clip;
-    }
-    if (effective_text.w <= 0 || effective_text.h <= 0) {
-        return;
-    }
-    clip_begin(&textbox->parent->base, &effective_text);
+    clip_begin(&textbox->parent->base, &text_clip);
 
     // Text to display
-    char* display_text = (textbox->is_active || textbox->text[0] != '\0') ? textbox->text : textbox->place_holder;
-    Color text_color = (display_text == textbox->place_holder) ? current_theme->text_secondary : current_theme->text_primary;
+    bool show_text = textbox->is_active || textbox->text.length > 0;
+    Color text_color = show_text ? current_theme->text_primary : current_theme->text_secondary;
 
     int text_x = sx + border_width + padding;
     int text_y = sy + border_width + padding;
     int max_text_width = sw - 2*(border_width + padding);
 
-    int num_lines = 0;
-    Line* lines = compute_visual_lines(display_text, max_text_width, font, &num_lines);
+    // The placeholder is wrapped on the fly into the scratch index;
+    // real text comes from the textbox's own index
+    WrapIndex* wi = NULL;
+    if (show_text) {
+        wi = textbox_wrap(textbox, max_text_width, font);
+    } else {
+        placeholder_wrap.count = 0;
+        wrap_range(&placeholder_wrap, textbox->place_holder, 0, (int)strlen(textbox->place_holder),
+                   max_text_width, font);
+    }
+    const Line* lines = show_text ? wi->lines : placeholder_wrap.lines;
+    int num_lines = show_text ? wi->count : placeholder_wrap.count;
     int visible_lines_count = (sh - 2*(border_width + padding)) / font_height;
 
     // Selection
@@ -149,15 +376,14 @@ void axRenderTextBox(axTextBox* textbox) {
         sel_max = textbox->selection_start < textbox->cursor_pos ? textbox->cursor_pos : textbox->selection_start;
     }
 
-    // Render visible lines
+    // Render visible lines; each one is drawn straight from the buffer, so
+    // the cost depends on the viewport, not on the size of the text
     for (int i = textbox->visible_line_start;
          i < num_lines && i < textbox->visible_line_start + visible_lines_count;
          ++i) {
         Line l = lines[i];
-        char* line_text = (char*)malloc(l.len + 1);
-        if (!line_text) continue;
-        strncpy(line_text, display_text + l.start, l.len);
-        line_text[l.len] = '\0';
+        const char* src = show_text ? text_buffer_range(&textbox->text, l.start, l.len)
+                                    : textbox->place_holder + l.start;
 
         int draw_y = text_y + (i - textbox->visible_line_start) * font_height;
 
@@ -169,83 +395,50 @@ void axRenderTextBox(axTextBox* textbox) {
                 int ov_start = sel_min > line_start ? sel_min : line_start;
                 int ov_end = sel_max < line_end ? sel_max : line_end;
 
-                char* prefix = (char*)malloc((ov_start - line_start) + 1);
-                if (prefix) {
-                    strncpy(prefix, display_text + line_start, ov_start - line_start);
-                    prefix[ov_start - line_start] = '\0';
-                    int offset = ttf_text_width(font, prefix);
-                    free(prefix);
-
-                    char* sel_part = (char*)malloc((ov_end - ov_start) + 1);
-                    if (sel_part) {
-                        strncpy(sel_part, display_text + ov_start, ov_end - ov_start);
-                        sel_part[ov_end - ov_start] = '\0';
-                        int w = ttf_text_width(font, sel_part);
-                        free(sel_part);
-
-                        draw_rect(&textbox->parent->base, text_x + offset, draw_y, w, font_height, current_theme->accent_hovered);
-                    }
+                const int* offsets = line_offsets(font, src, l.len);
+                if (offsets) {
+                    int offset = offsets[ov_start - line_start];
+                    int w = offsets[ov_end - line_start] - offset;
+                    draw_rect(&textbox->parent->base, text_x + offset, draw_y, w, font_height, current_theme->accent_hovered);
                 }
             }
         }
 
         // Draw text using wrapper
-        draw_text_from_font(&textbox->parent->base, font, line_text, text_x, draw_y, text_color, ALIGN_LEFT);
-        free(line_text);
+        draw_text_from_font_n(&textbox->parent->base, font, src, l.len, text_x, draw_y, text_color, ALIGN_LEFT);
     }
 
     // Cursor
-    if (textbox->is_active && font) {
-        for (int i = 0; i < num_lines; ++i) {
-            Line l = lines[i];
-            if (textbox->cursor_pos >= l.start && textbox->cursor_pos <= l.start + l.len) {
-                if (i < textbox->visible_line_start || i >= textbox->visible_line_start + visible_lines_count)
-                    break;
-
-                int rel_line = i - textbox->visible_line_start;
-                int draw_y = text_y + rel_line * font_height;
-
-                char* prefix = (char*)malloc((textbox->cursor_pos - l.start) + 1);
-                if (prefix) {
-                    strncpy(prefix, display_text + l.start, textbox->cursor_pos - l.start);
-                    prefix[textbox->cursor_pos - l.start] = '\0';
-                    int cursor_offset = ttf_text_width(font, prefix);
-                    free(prefix);
-
-                    int cursor_x = text_x + cursor_offset;
-                    int cursor_w = (int)roundf(2 * dpi);
-                    draw_rect(&textbox->parent->base, cursor_x, draw_y, cursor_w, font_height, current_theme->accent);
-                }
-                break;
-            }
+    int i = (textbox->is_active && wi) ? wrap_line_of(wi, textbox->cursor_pos) : -1;
+    if (i >= textbox->visible_line_start && i < textbox->visible_line_start + visible_lines_count) {
+        Line l = lines[i];
+        int rel_line = i - textbox->visible_line_start;
+        int draw_y = text_y + rel_line * font_height;
+
+        const int* offsets = line_offsets(font, text_buffer_range(&textbox->text, l.start, l.len), l.len);
+        if (offsets) {
+            int cursor_offset = offsets[textbox->cursor_pos - l.start];
+            int cursor_x = text_x + cursor_offset;
+            int cursor_w = (int)roundf(2 * dpi);
+            draw_rect(&textbox->parent->base, cursor_x, draw_y, cursor_w, font_height, current_theme->accent);
         }
     }
 
-    free(lines);
-
-    clip_end(&textbox->parent->base);
+    clip_end(&textbox->parent->base);   // text clip
+    clip_end(&textbox->parent->base);   // parent clip
 }
 
 void update_visible_lines(axTextBox* textbox) {
     if (!textbox || !textbox->parent || !global_font) return;
 
-    float dpi = textbox->parent->base.dpi_scale;
-    int logical_padding = current_theme->padding;
-    int max_text_width = textbox->w - 2 * logical_padding;
-
-    int num_lines = 0;
-    Line* lines = compute_visual_lines(textbox->text, max_text_width, global_font, &num_lines);
-    int visible_lines = (textbox->h - 2 * logical_padding) / textbox->line_height;
-
-    int cursor_line = -1;
-    for (int i = 0; i < num_lines; i++) {
-        Line l = lines[i];
-        if (textbox->cursor_pos >= l.start && textbox->cursor_pos <= l.start + l.len) {
-            cursor_line = i;
-            break;
-        }
-    }
+    Rect area = textbox_text_rect(textbox);
+    WrapIndex* wi = textbox_wrap(textbox, area.w, global_font);
+    int num_lines = wi->count;
+    int line_h = ttf_line_skip(global_font);
+    if (line_h <= 0) line_h = textbox->line_height;
+    int visible_lines = area.h / line_h;
 
+    int cursor_line = wrap_line_of(wi, textbox->cursor_pos);
     if (cursor_line != -1) {
         if (cursor_line < textbox->visible_line_start) {
             textbox->visible_line_start = cursor_line;
@@ -257,22 +450,26 @@ void update_visible_lines(axTextBox* textbox) {
         textbox->visible_line_start = num_lines - visible_lines;
     }
     if (textbox->visible_line_start < 0) textbox->visible_line_start = 0;
-
-    free(lines);
 }
 
 void axUpdateTextBox(axTextBox* textbox, axEvent* event) {
     if (!textbox || !textbox->parent || !textbox->parent->is_open || !global_font) return;
 
-    float dpi = textbox->parent->base.dpi_scale;
     Uint16 mod = input_get_mod_state();
-    int abs_x = textbox->x + textbox->parent->x;
-    int abs_y = textbox->y + textbox->parent->y + textbox->parent->title_height;
-    int s_abs_x = (int)roundf(abs_x * dpi);
-    int s_abs_y = (int)roundf(abs_y * dpi);
-    int s_w = (int)roundf(textbox->w * dpi);
-    int s_h = (int)roundf(textbox->h * dpi);
-    int logical_padding = current_theme->padding;
+
+    // Snapshot of everything the render depends on, for damage tracking
+    int was_active  = textbox->is_active;
+    int old_cursor  = textbox->cursor_pos;
+    int old_sel     = textbox->selection_start;
+    int old_visible = textbox->visible_line_start;
+    bool maybe_edit = textbox->is_active &&
+                      (event->type == EVENT_KEYDOWN || event->type == EVENT_TEXTINPUT);
+
+    const Rect* g = widget_geom(&textbox->geom, textbox->parent, textbox->x, textbox->y, textbox->w, textbox->h);
+    int s_abs_x = g->x;
+    int s_abs_y = g->y;
+    int s_w = g->w;
+    int s_h = g->h;
 
     Font_ttf* font = global_font;
 
@@ -283,31 +480,8 @@ void axUpdateTextBox(axTextBox* textbox, axEvent* event) {
             textbox->is_active = 1;
             textbox->is_mouse_selecting = 1;
             textbox->selection_start = -1;
-
-            int logical_mouse_x = (int)roundf(mouseX / dpi);
-            int logical_mouse_y = (int)roundf(mouseY / dpi);
-            int click_y = logical_mouse_y - (abs_y + logical_padding);
-            int clicked_line = textbox->visible_line_start + click_y / textbox->line_height;
-            int max_text_width = textbox->w - 2 * logical_padding;
-
-            int num_lines = 0;
-            Line* lines = compute_visual_lines(textbox->text, max_text_width, font, &num_lines);
-            if (clicked_line < num_lines) {
-                Line l = lines[clicked_line];
-                int click_x = logical_mouse_x - (abs_x + logical_padding);
-                int cum_width = 0;
-                textbox->cursor_pos = l.start;
-                for (int j = 0; j < l.len; j++) {
-                    char ch[2] = {textbox->text[l.start + j], '\0'};
-                    int char_w = ttf_text_width(font, ch);
-                    if (cum_width + char_w / 2 > click_x) break;
-                    cum_width += char_w;
-                    textbox->cursor_pos = l.start + j + 1;
-                }
-            } else {
-                textbox->cursor_pos = strlen(textbox->text);
-            }
-            free(lines);
+            textbox->cursor_pos = textbox_hit_test(textbox, mouseX, mouseY);
+            text_buffer_break_undo(&textbox->text);
             update_visible_lines(textbox);
         } else {
             textbox->is_active = 0;
@@ -323,76 +497,31 @@ void axUpdateTextBox(axTextBox* textbox, axEvent* event) {
         int mouseY = event->mouseMove.y;
         if (mouseX >= s_abs_x && mouseX <= s_abs_x + s_w && mouseY >= s_abs_y && mouseY <= s_abs_y + s_h) {
             if (textbox->selection_start == -1) textbox->selection_start = textbox->cursor_pos;
-
-            int logical_mouse_x = (int)roundf(mouseX / dpi);
-            int logical_mouse_y = (int)roundf(mouseY / dpi);
-            int click_y = logical_mouse_y - (abs_y + logical_padding);
-            int clicked_line = textbox->visible_line_start + click_y / textbox->line_height;
-            int max_text_width = textbox->w - 2 * logical_padding;
-
-            int num_lines = 0;
-            Line* lines = compute_visual_lines(textbox->text, max_text_width, font, &num_lines);
-            if (clicked_line < num_lines) {
-                Line l = lines[clicked_line];
-                int click_x = logical_mouse_x - (abs_x + logical_padding);
-                int cum_width = 0;
-                textbox->cursor_pos = l.start;
-                for (int j = 0; j < l.len; j++) {
-                    char ch[2] = {textbox->text[l.start + j], '\0'};
-                    int char_w = ttf_text_width(font, ch);
-                    if (cum_width + char_w / 2 > click_x) break;
-                    cum_width += char_w;
-                    textbox->cursor_pos = l.start + j + 1;
-                }
-            } else {
-                textbox->cursor_pos = strlen(textbox->text);
-            }
-            free(lines);
+            textbox->cursor_pos = textbox_hit_test(textbox, mouseX, mouseY);
             update_visible_lines(textbox);
         }
     }
     else if (event->type == EVENT_TEXTINPUT && textbox->is_active) {
-        if (textbox->selection_start != -1) {
-            int sel_start = textbox->selection_start < textbox->cursor_pos ? textbox->selection_start : textbox->cursor_pos;
-            int sel_end = textbox->selection_start < textbox->cursor_pos ? textbox->cursor_pos : textbox->selection_start;
-            memmove(textbox->text + sel_start, textbox->text + sel_end, strlen(textbox->text) - sel_end + 1);
-            textbox->cursor_pos = sel_start;
-            textbox->selection_start = -1;
-        }
-        int len = strlen(textbox->text);
-        int input_len = strlen(event->text.text);
-        if (len + input_len < textbox->max_length) {
-            memmove(textbox->text + textbox->cursor_pos + input_len, textbox->text + textbox->cursor_pos, len - textbox->cursor_pos + 1);
-            strncpy(textbox->text + textbox->cursor_pos, event->text.text, input_len);
-            textbox->cursor_pos += input_len;
+        if (textbox_replace_selection(textbox, event->text.text, strlen(event->text.text))) {
             update_visible_lines(textbox);
         }
     }
     else if (event->type == EVENT_KEYDOWN && textbox->is_active) {
-        // All key handling uses global_font via compute_visual_lines and update_visible_lines
-        // (No direct TTF calls — all through wrapper)
+        int len = textbox->text.length;
         if (event->key.key == KEY_BACKSPACE) {
             if (textbox->selection_start != -1) {
-                int sel_start = textbox->selection_start < textbox->cursor_pos ? textbox->selection_start : textbox->cursor_pos;
-                int sel_end = textbox->selection_start < textbox->cursor_pos ? textbox->cursor_pos : textbox->selection_start;
-                memmove(textbox->text + sel_start, textbox->text + sel_end, strlen(textbox->text) - sel_end + 1);
-                textbox->cursor_pos = sel_start;
-                textbox->selection_start = -1;
+                textbox_replace_selection(textbox, NULL, 0);
             } else if (textbox->cursor_pos > 0) {
-                memmove(textbox->text + textbox->cursor_pos - 1, textbox->text + textbox->cursor_pos, strlen(textbox->text) - textbox->cursor_pos + 1);
+                textbox_replace(textbox, textbox->cursor_pos - 1, 1, NULL, 0);
                 textbox->cursor_pos--;
             }
             update_visible_lines(textbox);
         }
         else if (event->key.key == KEY_DELETE) {
             if (textbox->selection_start != -1) {
-                int sel_start = textbox->selection_start < textbox->cursor_pos ? textbox->selection_start : textbox->cursor_pos;
-                int sel_end = textbox->selection_start < textbox->cursor_pos ? textbox->cursor_pos : textbox->selection_start;
-                memmove(textbox->text + sel_start, textbox->text + sel_end, strlen(textbox->text) - sel_end + 1);
-                textbox->cursor_pos = sel_start;
-                textbox->selection_start = -1;
-            } else if (textbox->cursor_pos < strlen(textbox->text)) {
-                memmove(textbox->text + textbox->cursor_pos, textbox->text + textbox->cursor_pos + 1, strlen(textbox->text) - textbox->cursor_pos);
+                textbox_replace_selection(textbox, NULL, 0);
+            } else if (textbox->cursor_pos < len) {
+                textbox_replace(textbox, textbox->cursor_pos, 1, NULL, 0);
             }
             update_visible_lines(textbox);
         }
@@ -400,132 +529,90 @@ void axUpdateTextBox(axTextBox* textbox, axEvent* event) {
             int delta = (event->key.key == KEY_RIGHT) ? 1 : -1;
             if (mod & KMOD_SHIFT) {
                 if (textbox->selection_start == -1) textbox->selection_start = textbox->cursor_pos;
-                textbox->cursor_pos = fmax(0, fmin((int)strlen(textbox->text), textbox->cursor_pos + delta));
+                textbox->cursor_pos = fmax(0, fmin(len, textbox->cursor_pos + delta));
             } else {
-                textbox->cursor_pos = fmax(0, fmin((int)strlen(textbox->text), textbox->cursor_pos + delta));
+                textbox->cursor_pos = fmax(0, fmin(len, textbox->cursor_pos + delta));
                 textbox->selection_start = -1;
             }
+            text_buffer_break_undo(&textbox->text);
             update_visible_lines(textbox);
         }
         else if (event->key.key == KEY_UP || event->key.key == KEY_DOWN) {
-            int max_text_width = textbox->w - 2 * logical_padding;
-            int num_lines = 0;
-            Line* lines = compute_visual_lines(textbox->text, max_text_width, font, &num_lines);
-
-            int curr_line_idx = -1;
-            int curr_offset_chars = 0;
+            WrapIndex* wi = textbox_wrap(textbox, textbox_text_rect(textbox).w, font);
             int old_cursor_pos = textbox->cursor_pos;
-            for (int i = 0; i < num_lines; i++) {
-                Line l = lines[i];
-                if (textbox->cursor_pos >= l.start && textbox->cursor_pos <= l.start + l.len) {
-                    curr_line_idx = i;
-                    curr_offset_chars = textbox->cursor_pos - l.start;
-                    break;
-                }
-            }
+            int curr_line_idx = wrap_line_of(wi, textbox->cursor_pos);
 
             if (curr_line_idx != -1) {
-                char* temp = (char*)malloc(curr_offset_chars + 1);
-                if (temp) {
-                    strncpy(temp, textbox->text + lines[curr_line_idx].start, curr_offset_chars);
-                    temp[curr_offset_chars] = '\0';
-                    int preferred_width = ttf_text_width(font, temp);
-                    free(temp);
-
-                    int delta = (event->key.key == KEY_DOWN) ? 1 : -1;
-                    int target_line_idx = curr_line_idx + delta;
-                    if (target_line_idx >= 0 && target_line_idx < num_lines) {
-                        Line target_l = lines[target_line_idx];
-                        int accum_w = 0;
-                        int target_offset = 0;
-                        for (int j = 0; j < target_l.len; j++) {
-                            char ch[2] = {textbox->text[target_l.start + j], '\0'};
-                            int char_w = ttf_text_width(font, ch);
-                            if (accum_w + char_w / 2 > preferred_width) break;
-                            accum_w += char_w;
-                            target_offset++;
-                        }
-                        if (accum_w < preferred_width) target_offset = target_l.len;
-                        textbox->cursor_pos = target_l.start + target_offset;
-                    } else if (target_line_idx < 0) {
-                        textbox->cursor_pos = 0;
-                    } else {
-                        textbox->cursor_pos = strlen(textbox->text);
-                    }
+                Line curr_l = wi->lines[curr_line_idx];
+                const int* offsets = line_offsets(font, text_buffer_range(&textbox->text, curr_l.start, curr_l.len), curr_l.len);
+                int preferred_width = offsets ? offsets[textbox->cursor_pos - curr_l.start] : 0;
+
+                int delta = (event->key.key == KEY_DOWN) ? 1 : -1;
+                int target_line_idx = curr_line_idx + delta;
+                if (target_line_idx >= 0 && target_line_idx < wi->count) {
+                    Line target_l = wi->lines[target_line_idx];
+                    const char* target = text_buffer_range(&textbox->text, target_l.start, target_l.len);
+                    offsets = line_offsets(font, target, target_l.len);
+                    int target_offset = offsets ? ttf_caret_at_x(target, offsets, target_l.len, preferred_width) : 0;
+                    textbox->cursor_pos = target_l.start + target_offset;
+                } else if (target_line_idx < 0) {
+                    textbox->cursor_pos = 0;
+                } else {
+                    textbox->cursor_pos = len;
                 }
             }
-            free(lines);
             if (mod & KMOD_SHIFT) {
                 if (textbox->selection_start == -1) textbox->selection_start = old_cursor_pos;
             } else {
                 textbox->selection_start = -1;
             }
+            text_buffer_break_undo(&textbox->text);
             update_visible_lines(textbox);
         }
         else if (event->key.key == KEY_RETURN) {
-            int len = strlen(textbox->text);
-            if (len + 1 < textbox->max_length) {
-                memmove(textbox->text + textbox->cursor_pos + 1, textbox->text + textbox->cursor_pos, len - textbox->cursor_pos + 1);
-                textbox->text[textbox->cursor_pos] = '\n';
-                textbox->cursor_pos++;
+            if (textbox_replace_selection(textbox, "\n", 1)) {
+                update_visible_lines(textbox);
+            }
+        }
+        // Ctrl+Z undo, Ctrl+Y / Ctrl+Shift+Z redo
+        else if ((event->key.key == KEY_Z || event->key.key == KEY_Y) && (event->key.mod & KEY_MOD_CTRL)) {
+            bool redo = event->key.key == KEY_Y || (event->key.mod & KEY_MOD_SHIFT);
+            TextChange change;
+            if (redo ? text_buffer_redo(&textbox->text, &change) : text_buffer_undo(&textbox->text, &change)) {
+                textbox_apply_change(textbox, &change);
                 update_visible_lines(textbox);
             }
         }
-        // Ctrl+A, C, X, V unchanged — no font calls
+        // Ctrl+A, C, X, V
         else if (event->key.key == KEY_A && (event->key.mod & KEY_MOD_CTRL)) {
-            if (strlen(textbox->text) > 0) {
+            if (len > 0) {
                 textbox->selection_start = 0;
-                textbox->cursor_pos = strlen(textbox->text);
+                textbox->cursor_pos = len;
             }
         }
-        else if (event->key.key == KEY_C && (event->key.mod & KEY_MOD_CTRL)) {
+        else if ((event->key.key == KEY_C || event->key.key == KEY_X) && (event->key.mod & KEY_MOD_CTRL)) {
             if (textbox->selection_start != -1) {
                 int sel_start = textbox->selection_start < textbox->cursor_pos ? textbox->selection_start : textbox->cursor_pos;
                 int sel_len = abs(textbox->cursor_pos - textbox->selection_start);
                 char* sel_text = malloc(sel_len + 1);
                 if (sel_text) {
-                    strncpy(sel_text, textbox->text + sel_start, sel_len);
-                    sel_text[sel_len] = '\0';
+                    text_buffer_copy(&textbox->text, sel_start, sel_len, sel_text);
                     clipboard_set_text(sel_text);
                     free(sel_text);
                 }
-            }
-        }
-        else if (event->key.key == KEY_X && (event->key.mod & KEY_MOD_CTRL)) {
-            if (textbox->selection_start != -1) {
-                int sel_start = textbox->selection_start < textbox->cursor_pos ? textbox->selection_start : textbox->cursor_pos;
-                int sel_len = abs(textbox->cursor_pos - textbox->selection_start);
-                char* sel_text = malloc(sel_len + 1);
-                if (sel_text) {
-                    strncpy(sel_text, textbox->text + sel_start, sel_len);
-                    sel_text[sel_len] = '\0';
-                    clipboard_set_text(sel_text);
-                    free(sel_text);
+                if (event->key.key == KEY_X) {
+                    textbox_replace_selection(textbox, NULL, 0);
+                    update_visible_lines(textbox);
                 }
-                memmove(textbox->text + sel_start, textbox->text + sel_start + sel_len, strlen(textbox->text) - (sel_start + sel_len) + 1);
-                textbox->cursor_pos = sel_start;
-                textbox->selection_start = -1;
-                update_visible_lines(textbox);
             }
         }
         else if (event->key.key == KEY_V && (event->key.mod & KEY_MOD_CTRL)) {
             if (clipboard_has_text()) {
                 char* paste_text = clipboard_get_text();
                 if (paste_text) {
-                    int paste_len = strlen(paste_text);
-                    int len = strlen(textbox->text);
-                    if (textbox->selection_start != -1) {
-                        int sel_start = textbox->selection_start < textbox->cursor_pos ? textbox->selection_start : textbox->cursor_pos;
-                        int sel_len = abs(textbox->cursor_pos - textbox->selection_start);
-                        memmove(textbox->text + sel_start, textbox->text + sel_start + sel_len, len - (sel_start + sel_len) + 1);
-                        textbox->cursor_pos = sel_start;
-                        textbox->selection_start = -1;
-                        len -= sel_len;
-                    }
-                    if (len + paste_len < textbox->max_length) {
-                        memmove(textbox->text + textbox->cursor_pos + paste_len, textbox->text + textbox->cursor_pos, len - textbox->cursor_pos + 1);
-                        strncpy(textbox->text + textbox->cursor_pos, paste_text, paste_len);
-                        textbox->cursor_pos += paste_len;
+                    text_buffer_break_undo(&textbox->text);   // a paste is its own undo step
+                    if (textbox_replace_selection(textbox, paste_text, strlen(paste_text))) {
+                        text_buffer_break_undo(&textbox->text);
                         update_visible_lines(textbox);
                     }
                     clipboard_free(paste_text);
@@ -533,101 +620,64 @@ void axUpdateTextBox(axTextBox* textbox, axEvent* event) {
             }
         }
     }
+
+    if (maybe_edit || textbox->is_active != was_active || textbox->cursor_pos != old_cursor ||
+        textbox->selection_start != old_sel || textbox->visible_line_start != old_visible) {
+        axInvalidateWidget(textbox->parent, textbox->x, textbox->y, textbox->w, textbox->h);
+    }
 }
 
-// compute_visual_lines using wrapper
+// compute_visual_lines using wrapper (one-off wrap; textboxes keep a WrapIndex instead)
 Line* compute_visual_lines(const char* text, int max_width, Font_ttf* font, int* num_lines) {
     *num_lines = 0;
     if (!text || !font) return NULL;
 
-    int text_len = strlen(text);
-    int max_lines = text_len * 2 + 2;
-    Line* lines = (Line*)malloc(sizeof(Line) * max_lines);
-    if (!lines) return NULL;
-
-    int line_start = 0;
-    for (int pos = 0; pos <= text_len; pos++) {
-        if (pos == text_len || text[pos] == '\n') {
-            int seg_start = line_start;
-            int seg_len = pos - line_start;
-            int seg_pos = 0;
-            while (seg_pos < seg_len) {
-                int line_start_local = seg_pos;
-                int last_space = -1;
-                int current_width = 0;
-                while (seg_pos < seg_len) {
-                    char ch[2] = {text[seg_start + seg_pos], '\0'};
-                    int char_w = ttf_text_width(font, ch);
-                    if (current_width + char_w > max_width) {
-                        if (current_width == 0) {
-                            current_width += char_w;
-                            if (isspace(ch[0])) last_space = seg_pos;
-                            seg_pos++;
-                            continue;
-                        }
-                        int add_len = (last_space != -1) ? (last_space - line_start_local) : (seg_pos - line_start_local);
-                        if (add_len > 0) {
-                            lines[*num_lines].start = seg_start + line_start_local;
-                            lines[*num_lines].len = add_len;
-                            (*num_lines)++;
-                        }
-                        line_start_local = seg_pos = last_space != -1 ? last_space + 1 : seg_pos;
-                        current_width = 0;
-                        last_space = -1;
-                        continue;
-                    }
-                    current_width += char_w;
-                    if (isspace(text[seg_start + seg_pos])) last_space = seg_pos;
-                    seg_pos++;
-                }
-                int add_len = seg_pos - line_start_local;
-                if (add_len > 0 || (add_len == 0 && seg_len == 0)) {
-                    lines[*num_lines].start = seg_start + line_start_local;
-                    lines[*num_lines].len = add_len;
-                    (*num_lines)++;
-                }
-            }
-            if (seg_len == 0) {
-                lines[*num_lines].start = seg_start;
-                lines[*num_lines].len = 0;
-                (*num_lines)++;
-            }
-            line_start = pos + 1;
-        }
+    WrapIndex wi = {0};
+    if (!wrap_range(&wi, text, 0, strlen(text), max_width, font)) {
+        free(wi.lines);
+        return NULL;
     }
-    return lines;
+    *num_lines = wi.count;
+    return wi.lines;
 }
 
-// Registration functions unchanged
-axTextBox* textbox_widgets[MAX_TEXTBOXS];
-int textboxs_count = 0;
-void axRegisterTextBox(axTextBox* textbox) {
-    if (textboxs_count < MAX_TEXTBOXS) {
-        textbox_widgets[textboxs_count++] = textbox;
+void axFreeTextBox(axTextBox* textbox) {
+    if (textbox) {
+        text_buffer_free(&textbox->text);
+        free(textbox->wrap.lines);
+        memset(&textbox->wrap, 0, sizeof(textbox->wrap));
+        wrap_scratch_free();
     }
 }
+
+/* --------------------------------------------------------------------- */
+/* Registration */
+/* --------------------------------------------------------------------- */
+static void textbox_update(void* w, axEvent* ev) { axUpdateTextBox((axTextBox*)w, ev); }
+static void textbox_render(void* w) { axRenderTextBox((axTextBox*)w); }
+static void textbox_free(void* w) { axFreeTextBox((axTextBox*)w); }
+
+static bool textbox_bounds(void* w, Rect* out) {
+    axTextBox* t = (axTextBox*)w;
+    if (!t->parent || !t->parent->is_open) return false;
+    *out = widget_visible_rect(&t->geom, t->parent, t->x, t->y, t->w, t->h);
+    return true;
+}
+
+const axWidgetClass textbox_class = {
+    "textbox", textbox_update, textbox_render, textbox_free, textbox_bounds, textbox_bounds,
+    AX_PHASE_UPDATE_TEXTBOXES, AX_PHASE_RENDER_TEXTBOXES, AX_Z_WIDGETS, 0
+};
+
+axWidgetHandle axRegisterTextBox(axTextBox* t) {
+    return axRegisterWidget(t, &textbox_class);
+}
 void axRenderAllRegisteredTextBoxes(void) {
-    for (int i = 0; i < textboxs_count; i++) {
-        if (textbox_widgets[i]) axRenderTextBox(textbox_widgets[i]);
-    }
+    registry_render_class(&textbox_class);
 }
-void axUpdateAllRegisteredTextBoxes(axEvent *event) {
-    for (int i = 0; i < textboxs_count; i++) {
-        if (textbox_widgets[i]) axUpdateTextBox(textbox_widgets[i], event);
-    }
+void axUpdateAllRegisteredTextBoxes(axEvent* ev) {
+    registry_update_class(&textbox_class, ev);
 }
 void axFreeAllRegisteredTextBoxes(void) {
-    for (int i = 0; i < textboxs_count; i++) {
-        if (textbox_widgets[i]) {
-            axFreeTextBox(textbox_widgets[i]);
-            textbox_widgets[i] = NULL;
-        }
-    }
-    textboxs_count = 0;
-}
-void axFreeTextBox(axTextBox* textbox) {
-    if (textbox) {
-        free(textbox->text);
-        free(textbox->place_holder);
-    }
+    axFreeAllWidgets(&textbox_class);
 }
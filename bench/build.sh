@@ -0,0 +1,34 @@
+#!/bin/bash
+set -e  # exit if any command fails
+
+# Root directory of the benchmark
+ROOT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+
+# Build directory
+BUILD_DIR="$ROOT_DIR/build"
+mkdir -p "$BUILD_DIR"
+
+# Include directories
+INCLUDES="-I$ROOT_DIR/../axo/include -I$ROOT_DIR/../axo"
+
+# Find all source files in axo/ and bench/
+SRC_FILES=$(find "$ROOT_DIR/../axo" "$ROOT_DIR" -name '*.c' -not -path "$BUILD_DIR/*")
+
+# Compile each .c to .o in the build dir
+OBJ_FILES=""
+for SRC in $SRC_FILES; do
+    # preserve relative path for object files
+    REL_PATH="${SRC#$ROOT_DIR/../}"  # relative to axo/ or bench/
+    OBJ="$BUILD_DIR/${REL_PATH//\//_}.o" # replace / with _ to avoid subdirs
+    echo "Compiling $SRC -> $OBJ"
+    gcc -O2 -c "$SRC" $INCLUDES -o "$OBJ"
+    OBJ_FILES="$OBJ_FILES $OBJ"
+done
+
+# Link; heap calls are wrapped so main.c can count allocations per frame
+echo "Linking into $ROOT_DIR/bench"
+gcc $OBJ_FILES -o "$ROOT_DIR/bench" \
+    -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=strdup \
+    -lSDL2 -lSDL2_ttf -lSDL2_image -lm
+
+echo "Build complete. Run from $ROOT_DIR: ./bench [-n widgets] [-f frames]"
@@ -0,0 +1,345 @@
+// main.c -- widget throughput benchmark
+//
+// Builds N of every widget type on a headless (software renderer) root,
+// replays a fixed synthetic input script and reports frames/sec, the
+// per-widget cost of each update/render pass and heap allocations per frame.
+//
+// usage: ./bench [-n widgets_per_type] [-f frames] [-w warmup] [-i image]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../axo/axo.h"
+#include "../axo/include/core/intern.h"
+#include "../axo/asset/bin/fira_code.h"
+
+#define BENCH_W        1180
+#define BENCH_ROW      34
+#define BENCH_SCRIPT   12     // frames per scripted click/type cycle
+
+/* ---------- allocation counting ---------- */
+// Library objects are linked with -Wl,--wrap=malloc,... so every heap call
+// made by axo lands here; SDL's own allocations come in through
+// SDL_SetMemoryFunctions below.
+static unsigned long alloc_count = 0;
+static unsigned long alloc_bytes = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t size);
+char* __real_strdup(const char* s);
+
+void* __wrap_malloc(size_t size)            { alloc_count++; alloc_bytes += size; return __real_malloc(size); }
+void* __wrap_calloc(size_t n, size_t size)  { alloc_count++; alloc_bytes += n * size; return __real_calloc(n, size); }
+void* __wrap_realloc(void* p, size_t size)  { alloc_count++; alloc_bytes += size; return __real_realloc(p, size); }
+char* __wrap_strdup(const char* s)
+{
+    alloc_count++;
+    alloc_bytes += strlen(s) + 1;
+    return __real_strdup(s);
+}
+
+static void* sdl_malloc(size_t size)            { return __wrap_malloc(size); }
+static void* sdl_calloc(size_t n, size_t size)  { return __wrap_calloc(n, size); }
+static void* sdl_realloc(void* p, size_t size)  { return __wrap_realloc(p, size); }
+static void  sdl_free(void* p)                  { free(p); }
+
+/* ---------- widgets ---------- */
+static axButton      *bench_buttons;
+static axEntry       *bench_entries;
+static axTextBox     *bench_textboxes;
+static axDropDown    *bench_drops;
+static axSlider      *bench_sliders;
+static axProgressBar *bench_bars;
+static axRadioButton *bench_radios;
+static axText        *bench_texts;
+static axImage       *bench_images;
+
+static char* drop_options[] = {"Alpha", "Beta", "Gamma", "Delta", "Epsilon", "Zeta"};
+
+typedef struct {
+    const char*    name;
+    int            x, w, h;           // column layout
+    axProfilePhase update, render;
+} WidgetColumn;
+
+enum { COL_BUTTON, COL_ENTRY, COL_TEXTBOX, COL_DROP, COL_SLIDER,
+       COL_PROGRESS, COL_RADIO, COL_TEXT, COL_IMAGE, COL_COUNT };
+
+static const WidgetColumn columns[COL_COUNT] = {
+    [COL_BUTTON]   = { "button",   10,   110, 28, AX_PHASE_UPDATE_BUTTONS,      AX_PHASE_RENDER_BUTTONS },
+    [COL_ENTRY]    = { "entry",    130,  150, 28, AX_PHASE_UPDATE_ENTRIES,      AX_PHASE_RENDER_ENTRIES },
+    [COL_TEXTBOX]  = { "textbox",  290,  170, 28, AX_PHASE_UPDATE_TEXTBOXES,    AX_PHASE_RENDER_TEXTBOXES },
+    [COL_DROP]     = { "dropdown", 470,  130, 28, AX_PHASE_UPDATE_DROPDOWNS,    AX_PHASE_RENDER_DROPDOWNS },
+    [COL_SLIDER]   = { "slider",   610,  140, 14, AX_PHASE_UPDATE_SLIDERS,      AX_PHASE_RENDER_SLIDERS },
+    [COL_PROGRESS] = { "progress", 770,  140, 14, AX_PHASE_UPDATE_PROGRESSBARS, AX_PHASE_RENDER_PROGRESSBARS },
+    [COL_RADIO]    = { "radio",    930,  20,  20, AX_PHASE_UPDATE_RADIOS,       AX_PHASE_RENDER_RADIOS },
+    [COL_TEXT]     = { "text",     1010, 100, 20, AX_PHASE_UPDATE_TEXTS,        AX_PHASE_RENDER_TEXTS },
+    [COL_IMAGE]    = { "image",    1120, 28,  28, AX_PHASE_UPDATE_IMAGES,       AX_PHASE_RENDER_IMAGES },
+};
+
+static int row_y(int i) { return 10 + i * BENCH_ROW; }
+
+static void build_widgets(axParent* win, int n, const char* image_path)
+{
+    char label[32];
+    bench_buttons   = calloc(n, sizeof(*bench_buttons));
+    bench_entries   = calloc(n, sizeof(*bench_entries));
+    bench_textboxes = calloc(n, sizeof(*bench_textboxes));
+    bench_drops     = calloc(n, sizeof(*bench_drops));
+    bench_sliders   = calloc(n, sizeof(*bench_sliders));
+    bench_bars      = calloc(n, sizeof(*bench_bars));
+    bench_radios    = calloc(n, sizeof(*bench_radios));
+    bench_texts     = calloc(n, sizeof(*bench_texts));
+    bench_images    = calloc(n, sizeof(*bench_images));
+    if (!bench_buttons || !bench_entries || !bench_textboxes || !bench_drops || !bench_sliders ||
+        !bench_bars || !bench_radios || !bench_texts || !bench_images) {
+        printf("Failed to allocate %d widgets\n", n);
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++) {
+        int y = row_y(i);
+        const WidgetColumn* c;
+
+        c = &columns[COL_BUTTON];
+        snprintf(label, sizeof(label), "Button %d", i);
+        bench_buttons[i] = axCreateButton(win, c->x, y, c->w, c->h, label, NULL);
+        axRegisterButton(&bench_buttons[i]);
+
+        c = &columns[COL_ENTRY];
+        bench_entries[i] = axCreateEntry(win, c->x, y, c->w, 256);
+        axSetEntryPlaceHolder(&bench_entries[i], "type here");
+        axRegisterEntry(&bench_entries[i]);
+
+        c = &columns[COL_TEXTBOX];
+        bench_textboxes[i] = axCreateTextBox(win, c->x, y, c->w, 1024);
+        axRegisterTextBox(&bench_textboxes[i]);
+
+        c = &columns[COL_DROP];
+        bench_drops[i] = axCreateDropDown(win, c->x, y, c->w, c->h, drop_options,
+                                    (int)(sizeof(drop_options) / sizeof(drop_options[0])));
+        axRegisterDropDown(&bench_drops[i]);
+
+        c = &columns[COL_SLIDER];
+        bench_sliders[i] = axCreateSlider(win, c->x, y + 8, c->w, c->h, 0, 100, (i * 7) % 100, NULL);
+        axRegisterSlider(&bench_sliders[i]);
+
+        c = &columns[COL_PROGRESS];
+        bench_bars[i] = axCreateProgressBar(win, c->x, y + 8, c->w, c->h, 0, 100, (i * 13) % 100, true);
+        axRegisterProgressBar(&bench_bars[i]);
+
+        c = &columns[COL_RADIO];
+        snprintf(label, sizeof(label), "R%d", i);
+        bench_radios[i] = axCreateRadioButton(win, c->x, y + 4, c->w, c->h, label, i / 4 + 1);
+        axRegisterRadioButton(&bench_radios[i]);
+
+        c = &columns[COL_TEXT];
+        snprintf(label, sizeof(label), "Label %d", i);
+        bench_texts[i] = axCreateText(win, c->x, y + 4, label, 16, ALIGN_LEFT);
+        axRegisterText(&bench_texts[i]);
+
+        c = &columns[COL_IMAGE];
+        bench_images[i] = axCreateImage(win, c->x, y, image_path, c->w, c->h);
+        axRegisterImage(&bench_images[i]);
+    }
+}
+
+static void free_widgets(void)
+{
+    axFreeAllWidgets(NULL);
+    intern_reset();
+    radio_groups_reset();
+    free(bench_buttons);
+    free(bench_entries);
+    free(bench_textboxes);
+    free(bench_drops);
+    free(bench_sliders);
+    free(bench_bars);
+    free(bench_radios);
+    free(bench_texts);
+    free(bench_images);
+}
+
+/* ---------- synthetic input ---------- */
+static unsigned int rng = 0x2545F491u;   // fixed seed: every run replays the same script
+
+static unsigned int next_rand(void)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static void push_motion(int x, int y, int dx, int dy, Uint32 buttons_down)
+{
+    axEvent ev = {0};
+    ev.type = EVENT_MOUSEMOTION;
+    ev.mouseMove.x = x;
+    ev.mouseMove.y = y;
+    ev.mouseMove.dx = dx;
+    ev.mouseMove.dy = dy;
+    ev.mouseMove.button_state = buttons_down;
+    input_push_event(&ev);
+}
+
+static void push_button(EventType type, int x, int y)
+{
+    axEvent ev = {0};
+    ev.type = type;
+    ev.mouseButton.button = MOUSE_LEFT;
+    ev.mouseButton.x = x;
+    ev.mouseButton.y = y;
+    ev.mouseButton.clicks = 1;
+    input_push_event(&ev);
+}
+
+static void push_text(const char* s)
+{
+    axEvent ev = {0};
+    ev.type = EVENT_TEXTINPUT;
+    strncpy(ev.text.text, s, EVENT_TEXT_MAX - 1);
+    input_push_event(&ev);
+}
+
+static void push_key(Key key)
+{
+    axEvent ev = {0};
+    ev.type = EVENT_KEYDOWN;
+    ev.key.key = key;
+    input_push_event(&ev);
+    ev.type = EVENT_KEYUP;
+    input_push_event(&ev);
+}
+
+// One frame of the script: a cursor sweeping the window, and every
+// BENCH_SCRIPT frames a press/drag/release on some widget followed by typing
+static void script_frame(int frame, int n, int h)
+{
+    static int target_x = 0, target_y = 0;
+    static int last_x = 0, last_y = 0;
+    int phase = frame % BENCH_SCRIPT;
+    int x, y;
+
+    if (phase == 0) {
+        const WidgetColumn* c = &columns[next_rand() % COL_COUNT];
+        int row = next_rand() % n;
+        target_x = c->x + c->w / 2;
+        target_y = row_y(row) + c->h / 2;
+        x = target_x;
+        y = target_y;
+        push_motion(x, y, x - last_x, y - last_y, 0);
+        push_button(EVENT_MOUSEBUTTONDOWN, x, y);
+    } else if (phase < BENCH_SCRIPT / 2) {
+        // drag around the pressed point (moves slider thumbs, selects text)
+        x = target_x + (phase * 9) % 40 - 20;
+        y = target_y;
+        push_motion(x, y, x - last_x, y - last_y, MOUSE_BUTTON_LEFT_MASK);
+        if (phase == BENCH_SCRIPT / 2 - 1) push_button(EVENT_MOUSEBUTTONUP, x, y);
+    } else {
+        // sweep the hover point across the window while typing
+        x = (frame * 37) % BENCH_W;
+        y = (frame * 23) % h;
+        push_motion(x, y, x - last_x, y - last_y, 0);
+        push_text((frame & 1) ? "ab" : "c ");
+        if (phase == BENCH_SCRIPT - 1) push_key(KEY_BACKSPACE);
+    }
+    last_x = x;
+    last_y = y;
+}
+
+/* ---------- report ---------- */
+static void print_phase(const char* label, axProfilePhase phase, int n)
+{
+    axProfileStats s;
+    axProfilerGetPhase(phase, &s);
+    printf("  %-10s %9.4f %9.4f %10.2f\n", label, s.p50, s.p99, s.p50 * 1000.0 / n);
+}
+
+static void print_counter(axProfileCounter counter)
+{
+    axProfileStats s;
+    axProfilerGetCounter(counter, &s);
+    printf("  %-16s p50 %8.0f   p99 %8.0f\n", axProfilerCounterName(counter), s.p50, s.p99);
+}
+
+static void usage(const char* prog)
+{
+    printf("usage: %s [-n widgets_per_type] [-f frames] [-w warmup_frames] [-i image]\n", prog);
+}
+
+int main(int argc, char** argv)
+{
+    int n = 20, frames = 600, warmup = 60;
+    const char* image_path = "../examples/img.jpg";
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-n") == 0)      n = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-f") == 0) frames = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-w") == 0) warmup = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-i") == 0) image_path = argv[++i];
+        else { usage(argv[0]); return 1; }
+    }
+    if (n < 1) n = 1;
+    if (frames < 1) frames = 1;
+    if (warmup < 0) warmup = 0;
+
+    // must run before SDL allocates anything
+    SDL_SetMemoryFunctions(sdl_malloc, sdl_calloc, sdl_realloc, sdl_free);
+
+    int h = row_y(n) + 40;
+    axParent win = axCreateHeadlessWindow(BENCH_W, h);
+    if (!win.base.sdl_renderer) {
+        printf("Failed to create headless renderer\n");
+        return 1;
+    }
+    axInit();
+    global_font = acquire_font_mem(fira_code_ttf, fira_code_ttf_len, current_theme->default_font_size, 0);
+
+    build_widgets(&win, n, image_path);
+
+    axProfilerEnable(true);
+    for (int f = 0; f < warmup; f++) {
+        script_frame(f, n, h);
+        axRunFrame(&win);
+    }
+    axProfilerReset();
+
+    unsigned long allocs_start = alloc_count;
+    unsigned long bytes_start = alloc_bytes;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < frames; f++) {
+        script_frame(warmup + f, n, h);
+        axRunFrame(&win);
+    }
+    double seconds = (double)(SDL_GetPerformanceCounter() - t0) / (double)SDL_GetPerformanceFrequency();
+    unsigned long allocs = alloc_count - allocs_start;
+    unsigned long bytes = alloc_bytes - bytes_start;
+
+    printf("axo widget benchmark: %d of each widget, %d frames (%d warmup), %dx%d software renderer\n",
+           n, frames, warmup, BENCH_W, h);
+    printf("\n  frames/sec      %10.1f\n", frames / seconds);
+    printf("  ms/frame        %10.3f\n", seconds * 1000.0 / frames);
+    printf("  allocs/frame    %10.2f\n", (double)allocs / frames);
+    printf("  bytes/frame     %10.1f\n", (double)bytes / frames);
+
+    int window = frames < PROFILER_HISTORY ? frames : PROFILER_HISTORY;
+    printf("\nper pass, last %d frames (ms; us per widget at p50)\n", window);
+    printf("  %-10s %9s %9s %10s\n", "update", "p50", "p99", "us/widget");
+    for (int c = 0; c < COL_COUNT; c++) print_phase(columns[c].name, columns[c].update, n);
+    printf("  %-10s %9s %9s %10s\n", "render", "p50", "p99", "us/widget");
+    for (int c = 0; c < COL_COUNT; c++) print_phase(columns[c].name, columns[c].render, n);
+
+    axProfileStats s;
+    printf("\nframe\n");
+    axProfilerGetPhase(AX_PHASE_POLL, &s);
+    printf("  %-16s p50 %8.4f   p99 %8.4f ms\n", "poll", s.p50, s.p99);
+    axProfilerGetPhase(AX_PHASE_PRESENT, &s);
+    printf("  %-16s p50 %8.4f   p99 %8.4f ms\n", "present", s.p50, s.p99);
+    axProfilerGetPhase(AX_PHASE_FRAME, &s);
+    printf("  %-16s p50 %8.4f   p99 %8.4f ms\n", "frame", s.p50, s.p99);
+    for (int c = 0; c < AX_COUNTER_COUNT; c++) print_counter((axProfileCounter)c);
+
+    free_widgets();
+    free_parent(&win);
+    return 0;
+}
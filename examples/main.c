@@ -14,9 +14,9 @@ int main(void) {
       // Scale font size based on DPI
       int scaled_font_size = (int)(current_theme->default_font_size * dpi); // round to nearest int
 
-	RWops* bin = open_font_rw(fira_code_ttf,fira_code_ttf_len);
     // global_font = load_font_ttf("FiraCode-Regular.ttf", scaled_font_size);
-    global_font = load_font_rw(bin, scaled_font_size);
+    // Shared handle from the font registry, backed by the embedded blob
+    global_font = acquire_font_mem(fira_code_ttf, fira_code_ttf_len, scaled_font_size, 0);
 
     axParent container = axCreateContainer(&win, 10, 10, 360, 500);
 
@@ -80,6 +80,9 @@ int main(void) {
 
 //    Image  image = new_image(&app.window, 10, 0, "img.jpg", 0, 0 );
 // register_image(&image);
+
+    // Only repaint what changed, and sleep while nothing does
+    axSetRedrawMode(AX_REDRAW_ON_DEMAND);
     axRun(&win);
 
 